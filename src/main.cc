@@ -22,6 +22,34 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
               Napi::Function::New(env, SharedMemory::get_memory));
   exports.Set(Napi::String::New(env, "removeMemory"),
               Napi::Function::New(env, SharedMemory::remove_memory));
+  exports.Set(Napi::String::New(env, "hashMemory"),
+              Napi::Function::New(env, SharedMemory::hash_memory));
+  exports.Set(Napi::String::New(env, "compareMemory"),
+              Napi::Function::New(env, SharedMemory::compare_memory));
+  exports.Set(Napi::String::New(env, "readFileInto"),
+              Napi::Function::New(env, SharedMemory::read_file_into));
+  exports.Set(Napi::String::New(env, "writeFileFrom"),
+              Napi::Function::New(env, SharedMemory::write_file_from));
+  exports.Set(Napi::String::New(env, "copyIntoMemory"),
+              Napi::Function::New(env, SharedMemory::copy_into_memory));
+  exports.Set(Napi::String::New(env, "copyBetween"),
+              Napi::Function::New(env, SharedMemory::copy_between));
+  exports.Set(Napi::String::New(env, "fillMemory"),
+              Napi::Function::New(env, SharedMemory::fill_memory));
+  exports.Set(Napi::String::New(env, "createTable"),
+              Napi::Function::New(env, SharedMemory::create_table));
+  exports.Set(Napi::String::New(env, "openTable"),
+              Napi::Function::New(env, SharedMemory::open_table));
+  exports.Set(Napi::String::New(env, "getTableRowCount"),
+              Napi::Function::New(env, SharedMemory::get_table_row_count));
+  exports.Set(Napi::String::New(env, "setTableRowCount"),
+              Napi::Function::New(env, SharedMemory::set_table_row_count));
+  exports.Set(Napi::String::New(env, "tableFilterRange"),
+              Napi::Function::New(env, SharedMemory::table_filter_range));
+  exports.Set(Napi::String::New(env, "tableGather"),
+              Napi::Function::New(env, SharedMemory::table_gather));
+  exports.Set(Napi::String::New(env, "tableAggregate"),
+              Napi::Function::New(env, SharedMemory::table_aggregate));
   exports.Set(Napi::String::New(env, "version"),
               Napi::Function::New(env, version));
 
@@ -0,0 +1,224 @@
+#include "napi.h"
+#include "memory.hh"
+#include "kernels.hh"
+#include "../logger.hh"
+#include <memory>
+#include <vector>
+#include "manager.hh"
+
+namespace SharedMemory {
+    using Logger::logger;
+
+    // JS二进制数据（ArrayBuffer、SharedArrayBuffer、TypedArray、Buffer、DataView）的地址和长度
+    struct ByteSpan {
+        const uint8_t* data;
+        size_t length;
+    };
+
+    // 是否是SharedArrayBuffer，Node-API没有对应的判断接口，按instanceof判断
+    static bool is_shared_array_buffer(Napi::Env env, const Napi::Value& value) {
+        if (!value.IsObject()) {
+            return false;
+        }
+        Napi::Value constructor = env.Global().Get("SharedArrayBuffer");
+        return constructor.IsFunction() && value.As<Napi::Object>().InstanceOf(constructor.As<Napi::Function>());
+    }
+
+    /**
+     * 解析JS二进制数据，不支持的类型返回false
+     * napi_get_arraybuffer_info不接受SharedArrayBuffer，视图的地址通过napi_get_typedarray_info和
+     * napi_get_dataview_info获取，这两个接口对两种缓冲区都有效
+     */
+    static bool get_byte_span(Napi::Env env, const Napi::Value& value, ByteSpan& span) {
+        if (value.IsArrayBuffer()) {
+            Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+            span.data = static_cast<const uint8_t*>(buffer.Data());
+            span.length = buffer.ByteLength();
+            return true;
+        }
+        Napi::Value view = value;
+        if (is_shared_array_buffer(env, value)) {
+            // 包装成Uint8Array后按TypedArray读取
+            view = env.Global().Get("Uint8Array").As<Napi::Function>().New({ value });
+        }
+        void* data = nullptr;
+        if (view.IsTypedArray()) {
+            if (napi_get_typedarray_info(env, view, nullptr, nullptr, &data, nullptr, nullptr) != napi_ok) {
+                throw Napi::Error::New(env);
+            }
+            span.data = static_cast<const uint8_t*>(data);
+            span.length = view.As<Napi::TypedArray>().ByteLength();
+            return true;
+        }
+        if (view.IsDataView()) {
+            size_t length = 0;
+            if (napi_get_dataview_info(env, view, &length, &data, nullptr, nullptr) != napi_ok) {
+                throw Napi::Error::New(env);
+            }
+            span.data = static_cast<const uint8_t*>(data);
+            span.length = length;
+            return true;
+        }
+        return false;
+    }
+
+    Napi::Value copy_into_memory(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 3) {
+            throw Napi::Error::New(env, "至少需要三个参数: key、dstOffset和source");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        ByteSpan source;
+        if (!get_byte_span(env, info[2], source)) {
+            throw Napi::Error::New(env, "第三个参数必须是ArrayBuffer、SharedArrayBuffer、TypedArray或DataView类型的source");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Copy into memory call.");
+            auto manager = open_manager(key);
+            size_t size = manager->get_size();
+
+            size_t dst_offset = get_size_argument(info, 1, "dstOffset");
+            size_t src_offset = info.Length() > 3 && !info[3].IsUndefined() ? get_size_argument(info, 3, "srcOffset") : 0;
+            if (src_offset > source.length) {
+                throw Napi::Error::New(env, "srcOffset超出source范围");
+            }
+            // len可省略，默认拷贝source剩余的全部数据
+            size_t len = info.Length() > 4 && !info[4].IsUndefined() ? get_size_argument(info, 4, "len") : source.length - src_offset;
+            if (len > source.length - src_offset) {
+                throw Napi::Error::New(env, "srcOffset + len超出source范围");
+            }
+            if (dst_offset > size || len > size - dst_offset) {
+                throw Napi::Error::New(env, "dstOffset + len超出共享内存范围");
+            }
+
+            Kernels::copy(manager->get_data() + dst_offset, source.data + src_offset, len);
+            logger->debug("Copy into memory: key={}, dstOffset={}, srcOffset={}, len={}", key, dst_offset, src_offset, len);
+
+            return Napi::Number::New(env, static_cast<double>(len));
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "拷贝数据到共享内存时发生未知错误");
+        }
+    }
+
+    Napi::Value copy_between(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 5) {
+            throw Napi::Error::New(env, "需要五个参数: dstKey、dstOffset、srcKey、srcOffset和len");
+        }
+
+        if (!info[0].IsString() || !info[2].IsString()) {
+            throw Napi::Error::New(env, "dstKey和srcKey必须是字符串类型");
+        }
+
+        std::string dst_key = info[0].As<Napi::String>().Utf8Value();
+        std::string src_key = info[2].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Copy between memory call.");
+            auto dst_manager = open_manager(dst_key);
+            auto src_manager = open_manager(src_key);
+            size_t dst_size = dst_manager->get_size();
+            size_t src_size = src_manager->get_size();
+
+            size_t dst_offset = get_size_argument(info, 1, "dstOffset");
+            size_t src_offset = get_size_argument(info, 3, "srcOffset");
+            size_t len = get_size_argument(info, 4, "len");
+            if (dst_offset > dst_size || len > dst_size - dst_offset) {
+                throw Napi::Error::New(env, "dstOffset + len超出目标共享内存范围");
+            }
+            if (src_offset > src_size || len > src_size - src_offset) {
+                throw Napi::Error::New(env, "srcOffset + len超出源共享内存范围");
+            }
+
+            // 同一块共享内存内区域重叠时，Kernels::copy会按memmove处理
+            Kernels::copy(dst_manager->get_data() + dst_offset, src_manager->get_data() + src_offset, len);
+            logger->debug("Copy between memory: dstKey={}, dstOffset={}, srcKey={}, srcOffset={}, len={}",
+                dst_key, dst_offset, src_key, src_offset, len);
+
+            return Napi::Number::New(env, static_cast<double>(len));
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "共享内存之间拷贝数据时发生未知错误");
+        }
+    }
+
+    Napi::Value fill_memory(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 3) {
+            throw Napi::Error::New(env, "至少需要三个参数: key、offset和len");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        // pattern可以是单个字节的数值，也可以是二进制数据，省略时填充0
+        uint8_t byte_pattern = 0;
+        ByteSpan pattern{&byte_pattern, 1};
+        if (info.Length() > 3 && !info[3].IsUndefined()) {
+            if (info[3].IsNumber()) {
+                byte_pattern = static_cast<uint8_t>(info[3].As<Napi::Number>().Uint32Value());
+            } else if (!get_byte_span(env, info[3], pattern)) {
+                throw Napi::Error::New(env, "pattern必须是数字或ArrayBuffer、SharedArrayBuffer、TypedArray、DataView类型");
+            } else if (pattern.length == 0) {
+                throw Napi::Error::New(env, "pattern不能为空");
+            }
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Fill memory call.");
+            auto manager = open_manager(key);
+            size_t size = manager->get_size();
+
+            size_t offset = get_size_argument(info, 1, "offset");
+            size_t len = get_size_argument(info, 2, "len");
+            if (offset > size || len > size - offset) {
+                throw Napi::Error::New(env, "offset + len超出共享内存范围");
+            }
+
+            // pattern可能就是目标共享内存的视图，先复制一份避免填充过程中被覆盖
+            std::vector<uint8_t> pattern_copy(pattern.data, pattern.data + pattern.length);
+            Kernels::fill(manager->get_data() + offset, len, pattern_copy.data(), pattern_copy.size());
+            logger->debug("Fill memory: key={}, offset={}, len={}, patternLength={}", key, offset, len, pattern.length);
+
+            return Napi::Number::New(env, static_cast<double>(len));
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "填充共享内存时发生未知错误");
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include "cpu.hh"
+#include "../logger.hh"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace SharedMemory {
+    using Logger::logger;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    // MSVC下通过cpuid检测指令集
+    static CpuFeatures detect_cpu_features() {
+        CpuFeatures features{};
+        int regs[4] = {0};
+        __cpuid(regs, 0);
+        int max_leaf = regs[0];
+
+        __cpuid(regs, 1);
+        features.sse42 = (regs[2] & (1 << 20)) != 0;
+        bool osxsave = (regs[2] & (1 << 27)) != 0;
+        bool avx = (regs[2] & (1 << 28)) != 0;
+
+        // 操作系统需要保存YMM/ZMM寄存器状态，否则不能使用AVX指令
+        unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        bool ymm_enabled = (xcr0 & 0x6) == 0x6;
+        bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+
+        if (max_leaf >= 7) {
+            __cpuidex(regs, 7, 0);
+            features.avx2 = avx && ymm_enabled && (regs[1] & (1 << 5)) != 0;
+            features.avx512f = zmm_enabled && (regs[1] & (1 << 16)) != 0;
+        }
+        return features;
+    }
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // GCC/Clang下使用内建函数检测指令集
+    static CpuFeatures detect_cpu_features() {
+        CpuFeatures features{};
+        __builtin_cpu_init();
+        features.sse42 = __builtin_cpu_supports("sse4.2");
+        features.avx2 = __builtin_cpu_supports("avx2");
+        features.avx512f = __builtin_cpu_supports("avx512f");
+        return features;
+    }
+#else
+    // 非x86平台，全部使用标量实现
+    static CpuFeatures detect_cpu_features() {
+        return CpuFeatures{};
+    }
+#endif
+
+    const CpuFeatures& cpu_features() {
+        static const CpuFeatures features = [] {
+            CpuFeatures detected = detect_cpu_features();
+            logger->debug("CPU features: sse4.2={}, avx2={}, avx512f={}",
+                detected.sse42, detected.avx2, detected.avx512f);
+            return detected;
+        }();
+        return features;
+    }
+}
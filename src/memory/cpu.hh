@@ -0,0 +1,21 @@
+#pragma once
+
+#ifndef __CPU_HH__
+#define __CPU_HH__
+
+namespace SharedMemory {
+
+    // 运行时检测到的CPU指令集支持情况
+    struct CpuFeatures {
+        bool sse42;           // SSE4.2（含CRC32C指令）
+        bool avx2;            // AVX2
+        bool avx512f;         // AVX-512 Foundation
+    };
+
+    /**
+     * 获取当前CPU支持的指令集，首次调用时检测并缓存结果
+     * @return CPU指令集支持情况
+     */
+    const CpuFeatures& cpu_features();
+}
+#endif
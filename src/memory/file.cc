@@ -0,0 +1,493 @@
+#include "napi.h"
+#include "memory.hh"
+#include "../logger.hh"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include "manager.hh"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SharedMemory {
+    using Logger::logger;
+
+    // 默认每次读写的块大小，每完成一块检查一次取消并上报进度
+    constexpr size_t DEFAULT_CHUNK_SIZE = 8 * 1024 * 1024;
+
+    // 传输进度
+    struct TransferProgress {
+        uint64_t done;        // 已完成字节数
+        uint64_t total;       // 总字节数
+    };
+
+    // 文件传输方向
+    enum class TransferDirection {
+        FileToMemory,         // readFileInto
+        MemoryToFile,         // writeFileFrom
+    };
+
+    // 文件与共享内存之间的异步传输，直接在映射区域上pread/pwrite，不经过JS堆
+    class FileTransferWorker : public Napi::AsyncProgressWorker<TransferProgress> {
+    public:
+        FileTransferWorker(Napi::Env env, TransferDirection direction,
+            std::shared_ptr<SharedMemoryManager> manager, const std::string& path,
+            size_t offset, size_t length, size_t chunk_size)
+            : Napi::AsyncProgressWorker<TransferProgress>(env, "SharedMemoryFileTransfer"),
+              deferred_(Napi::Promise::Deferred::New(env)),
+              direction_(direction), manager_(std::move(manager)), path_(path),
+              offset_(offset), length_(length), chunk_size_(chunk_size),
+              transferred_(0), aborted_(false), cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+        Napi::Promise GetPromise() const { return deferred_.Promise(); }
+
+        // 监听进度回调
+        void SetProgressCallback(const Napi::Function& callback) {
+            progress_callback_ = Napi::Persistent(callback);
+        }
+
+        // 关联AbortSignal，已取消时任务启动后直接结束，否则监听abort事件，调用方需先校验signal
+        void SetAbortSignal(Napi::Env env, const Napi::Object& signal) {
+            signal_ = Napi::Persistent(signal);
+            if (signal.Get("aborted").ToBoolean()) {
+                cancelled_->store(true);
+                return;
+            }
+            auto cancelled = cancelled_;
+            auto on_abort = Napi::Function::New(env, [cancelled](const Napi::CallbackInfo&) {
+                cancelled->store(true);
+            });
+            signal.Get("addEventListener").As<Napi::Function>().Call(signal,
+                { Napi::String::New(env, "abort"), on_abort });
+            abort_listener_ = Napi::Persistent(on_abort);
+        }
+
+    protected:
+        void Execute(const ExecutionProgress& progress) override {
+            // signal已取消时不打开文件，空传输也要以signal.reason拒绝
+            if (check_cancelled()) {
+                return;
+            }
+            if (direction_ == TransferDirection::FileToMemory) {
+                read_file(progress);
+            } else {
+                write_file(progress);
+            }
+        }
+
+        void OnProgress(const TransferProgress* data, size_t count) override {
+            if (progress_callback_.IsEmpty() || count == 0) {
+                return;
+            }
+            Napi::Env env = Env();
+            Napi::HandleScope scope(env);
+            progress_callback_.Call({
+                Napi::Number::New(env, static_cast<double>(data->done)),
+                Napi::Number::New(env, static_cast<double>(data->total)),
+            });
+        }
+
+        void OnOK() override {
+            Napi::Env env = Env();
+            remove_abort_listener();
+            deferred_.Resolve(Napi::Number::New(env, static_cast<double>(transferred_)));
+        }
+
+        void OnError(const Napi::Error& error) override {
+            // 因取消而结束时，与其他支持AbortSignal的API一样以signal.reason拒绝
+            Napi::Value reason = aborted_ ? abort_reason() : error.Value();
+            remove_abort_listener();
+            deferred_.Reject(reason);
+        }
+
+    private:
+        void remove_abort_listener() {
+            if (signal_.IsEmpty()) {
+                return;
+            }
+            Napi::Env env = Env();
+            Napi::Object signal = signal_.Value();
+            Napi::Value remove = signal.Get("removeEventListener");
+            if (!abort_listener_.IsEmpty() && remove.IsFunction()) {
+                remove.As<Napi::Function>().Call(signal,
+                    { Napi::String::New(env, "abort"), abort_listener_.Value() });
+            }
+            signal_.Reset();
+            abort_listener_.Reset();
+        }
+
+        // signal.reason，没有时构造AbortError
+        Napi::Value abort_reason() {
+            Napi::Env env = Env();
+            if (!signal_.IsEmpty()) {
+                Napi::Value reason = signal_.Value().Get("reason");
+                if (!reason.IsUndefined()) {
+                    return reason;
+                }
+            }
+            Napi::Value dom_exception = env.Global().Get("DOMException");
+            if (dom_exception.IsFunction()) {
+                return dom_exception.As<Napi::Function>().New({
+                    Napi::String::New(env, "操作已取消"),
+                    Napi::String::New(env, "AbortError"),
+                });
+            }
+            Napi::Error error = Napi::Error::New(env, "操作已取消");
+            error.Value().Set("name", Napi::String::New(env, "AbortError"));
+            return error.Value();
+        }
+
+        char* target() const { return manager_->get_data() + offset_; }
+
+        // 已取消时记录错误并返回true
+        bool check_cancelled() {
+            if (!cancelled_->load()) {
+                return false;
+            }
+            aborted_ = true;
+            SetError("操作已取消");
+            return true;
+        }
+
+        // 按块循环读写，io(已完成字节数, 本块长度)返回本块实际传输的字节数，0表示结束，-1表示出错
+        template <typename IoFunction>
+        void transfer(const ExecutionProgress& progress, size_t total, IoFunction io) {
+            while (transferred_ < total) {
+                if (check_cancelled()) {
+                    return;
+                }
+                size_t chunk = (std::min)(chunk_size_, total - transferred_);
+                int64_t result = io(transferred_, chunk);
+                if (result < 0) {
+                    return;
+                }
+                if (result == 0) {
+                    break;
+                }
+                transferred_ += static_cast<size_t>(result);
+                TransferProgress current{transferred_, total};
+                progress.Send(&current, 1);
+            }
+        }
+
+#ifdef _WIN32
+        static std::wstring to_wide_path(const std::string& path) {
+            int count = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+            std::wstring wide(count > 0 ? count - 1 : 0, L'\0');
+            if (count > 1) {
+                MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], count);
+            }
+            return wide;
+        }
+
+        void read_file(const ExecutionProgress& progress) {
+            HANDLE file = CreateFileW(to_wide_path(path_).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (file == INVALID_HANDLE_VALUE) {
+                logger->debug("Failed to open file, error code: {}", GetLastError());
+                SetError("打开文件失败: " + path_);
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file, &file_size)) {
+                CloseHandle(file);
+                SetError("获取文件大小失败: " + path_);
+                return;
+            }
+            size_t total = static_cast<size_t>(file_size.QuadPart);
+            if (total > manager_->get_size() - offset_) {
+                CloseHandle(file);
+                SetError("文件大小超出共享内存范围: " + path_);
+                return;
+            }
+            transfer(progress, total, [&](size_t done, size_t chunk) -> int64_t {
+                OVERLAPPED overlapped{};
+                overlapped.Offset = static_cast<DWORD>(done);
+                overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(done) >> 32);
+                DWORD count = 0;
+                if (!ReadFile(file, target() + done, static_cast<DWORD>(chunk), &count, &overlapped)) {
+                    DWORD error = GetLastError();
+                    if (error == ERROR_HANDLE_EOF) {
+                        return 0;
+                    }
+                    logger->debug("Failed to read file, error code: {}", error);
+                    SetError("读取文件失败: " + path_);
+                    return -1;
+                }
+                return count;
+            });
+            CloseHandle(file);
+        }
+
+        void write_file(const ExecutionProgress& progress) {
+            HANDLE file = CreateFileW(to_wide_path(path_).c_str(), GENERIC_WRITE, 0,
+                NULL, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (file == INVALID_HANDLE_VALUE) {
+                logger->debug("Failed to create file, error code: {}", GetLastError());
+                SetError("创建文件失败: " + path_);
+                return;
+            }
+            transfer(progress, length_, [&](size_t done, size_t chunk) -> int64_t {
+                OVERLAPPED overlapped{};
+                overlapped.Offset = static_cast<DWORD>(done);
+                overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(done) >> 32);
+                DWORD count = 0;
+                if (!WriteFile(file, target() + done, static_cast<DWORD>(chunk), &count, &overlapped)) {
+                    logger->debug("Failed to write file, error code: {}", GetLastError());
+                    SetError("写入文件失败: " + path_);
+                    return -1;
+                }
+                return count;
+            });
+            CloseHandle(file);
+        }
+#else
+        void read_file(const ExecutionProgress& progress) {
+            int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd == -1) {
+                logger->debug("Failed to open file, error: {}", strerror(errno));
+                SetError("打开文件失败: " + path_ + ": " + strerror(errno));
+                return;
+            }
+            struct stat st;
+            if (fstat(fd, &st) == -1) {
+                close(fd);
+                SetError("获取文件大小失败: " + path_ + ": " + strerror(errno));
+                return;
+            }
+            size_t total = static_cast<size_t>(st.st_size);
+            if (total > manager_->get_size() - offset_) {
+                close(fd);
+                SetError("文件大小超出共享内存范围: " + path_);
+                return;
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            // 内核直接把页缓存拷贝到映射区域，只有一次拷贝
+            transfer(progress, total, [&](size_t done, size_t chunk) -> int64_t {
+                ssize_t count;
+                do {
+                    count = pread(fd, target() + done, chunk, static_cast<off_t>(done));
+                } while (count == -1 && errno == EINTR);
+                if (count == -1) {
+                    logger->debug("Failed to read file, error: {}", strerror(errno));
+                    SetError("读取文件失败: " + path_ + ": " + strerror(errno));
+                    return -1;
+                }
+                return count;
+            });
+            close(fd);
+        }
+
+        void write_file(const ExecutionProgress& progress) {
+            int fd = open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd == -1) {
+                logger->debug("Failed to create file, error: {}", strerror(errno));
+                SetError("创建文件失败: " + path_ + ": " + strerror(errno));
+                return;
+            }
+            transfer(progress, length_, [&](size_t done, size_t chunk) -> int64_t {
+                ssize_t count;
+                do {
+                    count = pwrite(fd, target() + done, chunk, static_cast<off_t>(done));
+                } while (count == -1 && errno == EINTR);
+                if (count == -1) {
+                    logger->debug("Failed to write file, error: {}", strerror(errno));
+                    SetError("写入文件失败: " + path_ + ": " + strerror(errno));
+                    return -1;
+                }
+                return count;
+            });
+            close(fd);
+        }
+#endif
+
+        Napi::Promise::Deferred deferred_;
+        TransferDirection direction_;
+        std::shared_ptr<SharedMemoryManager> manager_;    // 持有管理器，保证传输期间映射有效
+        std::string path_;
+        size_t offset_;
+        size_t length_;
+        size_t chunk_size_;
+        size_t transferred_;
+        bool aborted_;                                     // 是否因取消而结束
+        std::shared_ptr<std::atomic<bool>> cancelled_;
+        Napi::FunctionReference progress_callback_;
+        Napi::ObjectReference signal_;
+        Napi::FunctionReference abort_listener_;
+    };
+
+    /**
+     * 校验选项，在创建传输任务之前调用，保证之后启动任务时不会因选项抛出异常
+     * @param info 回调信息
+     * @param options_index 选项参数的位置
+     */
+    static void validate_options(const Napi::CallbackInfo &info, size_t options_index) {
+        if (info.Length() <= options_index || !info[options_index].IsObject()) {
+            return;
+        }
+        Napi::Env env = info.Env();
+        Napi::Object options = info[options_index].As<Napi::Object>();
+        Napi::Value on_progress = options.Get("onProgress");
+        if (!on_progress.IsUndefined() && !on_progress.IsFunction()) {
+            throw Napi::Error::New(env, "onProgress必须是函数");
+        }
+        Napi::Value signal = options.Get("signal");
+        if (!signal.IsUndefined() &&
+            (!signal.IsObject() || !signal.As<Napi::Object>().Get("addEventListener").IsFunction())) {
+            throw Napi::Error::New(env, "signal必须是AbortSignal");
+        }
+    }
+
+    /**
+     * 应用已校验的选项并启动传输
+     * @param info 回调信息
+     * @param options_index 选项参数的位置
+     * @param worker 传输任务
+     * @return Promise，完成时返回传输的字节数
+     */
+    static Napi::Value start_transfer(const Napi::CallbackInfo &info, size_t options_index,
+        FileTransferWorker* worker) {
+        Napi::Env env = info.Env();
+        try {
+            if (info.Length() > options_index && info[options_index].IsObject()) {
+                Napi::Object options = info[options_index].As<Napi::Object>();
+                Napi::Value on_progress = options.Get("onProgress");
+                if (on_progress.IsFunction()) {
+                    worker->SetProgressCallback(on_progress.As<Napi::Function>());
+                }
+                Napi::Value signal = options.Get("signal");
+                if (signal.IsObject()) {
+                    worker->SetAbortSignal(env, signal.As<Napi::Object>());
+                }
+            }
+        } catch (...) {
+            // 任务尚未入队，需要自行释放
+            delete worker;
+            throw;
+        }
+
+        Napi::Promise promise = worker->GetPromise();
+        worker->Queue();
+        return promise;
+    }
+
+    // 读取可选的chunkSize选项
+    static size_t get_chunk_size(const Napi::CallbackInfo &info, size_t options_index) {
+        if (info.Length() > options_index && info[options_index].IsObject()) {
+            Napi::Value chunk_size = info[options_index].As<Napi::Object>().Get("chunkSize");
+            if (chunk_size.IsNumber()) {
+                int64_t value = chunk_size.As<Napi::Number>().Int64Value();
+                if (value <= 0) {
+                    throw Napi::Error::New(info.Env(), "chunkSize必须大于0");
+                }
+                return static_cast<size_t>(value);
+            }
+        }
+        return DEFAULT_CHUNK_SIZE;
+    }
+
+    Napi::Value read_file_into(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 2) {
+            throw Napi::Error::New(env, "至少需要两个参数: key和path");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        if (!info[1].IsString()) {
+            throw Napi::Error::New(env, "第二个参数必须是字符串类型的path");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        std::string path = info[1].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Read file into memory call: key={}, path={}", key, path);
+            auto manager = open_manager(key);
+
+            size_t offset = info.Length() > 2 && !info[2].IsUndefined() ? get_size_argument(info, 2, "offset") : 0;
+            if (offset > manager->get_size()) {
+                throw Napi::Error::New(env, "offset超出共享内存范围");
+            }
+
+            validate_options(info, 3);
+            size_t chunk_size = get_chunk_size(info, 3);
+            auto worker = new FileTransferWorker(env, TransferDirection::FileToMemory, manager,
+                path, offset, 0, chunk_size);
+            return start_transfer(info, 3, worker);
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "读取文件到共享内存时发生未知错误");
+        }
+    }
+
+    Napi::Value write_file_from(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 2) {
+            throw Napi::Error::New(env, "至少需要两个参数: key和path");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        if (!info[1].IsString()) {
+            throw Napi::Error::New(env, "第二个参数必须是字符串类型的path");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        std::string path = info[1].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Write file from memory call: key={}, path={}", key, path);
+            auto manager = open_manager(key);
+            size_t size = manager->get_size();
+
+            // offset和len可省略，默认写出整个数据区
+            size_t offset = info.Length() > 2 && !info[2].IsUndefined() ? get_size_argument(info, 2, "offset") : 0;
+            if (offset > size) {
+                throw Napi::Error::New(env, "offset超出共享内存范围");
+            }
+            size_t len = info.Length() > 3 && !info[3].IsUndefined() ? get_size_argument(info, 3, "len") : size - offset;
+            if (len > size - offset) {
+                throw Napi::Error::New(env, "offset + len超出共享内存范围");
+            }
+
+            validate_options(info, 4);
+            size_t chunk_size = get_chunk_size(info, 4);
+            auto worker = new FileTransferWorker(env, TransferDirection::MemoryToFile, manager,
+                path, offset, len, chunk_size);
+            return start_transfer(info, 4, worker);
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "从共享内存写出文件时发生未知错误");
+        }
+    }
+}
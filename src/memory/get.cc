@@ -8,6 +8,27 @@
 
 namespace SharedMemory {
     using Logger::logger;
+    std::shared_ptr<SharedMemoryManager> open_manager(const std::string &key) {
+        if (auto target = managerMap.find(key);target != managerMap.end()) {
+            return target->second;
+        }
+        auto manager = std::make_shared<SharedMemoryManager>(key, false);
+        managerMap[key] = manager;
+        return manager;
+    }
+
+    size_t get_size_argument(const Napi::CallbackInfo &info, size_t index, const char *name) {
+        Napi::Env env = info.Env();
+        if (info.Length() <= index || !info[index].IsNumber()) {
+            throw Napi::Error::New(env, std::string("参数") + name + "必须是数字类型");
+        }
+        int64_t value = info[index].As<Napi::Number>().Int64Value();
+        if (value < 0) {
+            throw Napi::Error::New(env, std::string("参数") + name + "不能为负数");
+        }
+        return static_cast<size_t>(value);
+    }
+
     Napi::Value get_memory(const Napi::CallbackInfo &info) {
         Napi::Env env = info.Env();
         
@@ -26,11 +47,8 @@ namespace SharedMemory {
             logger->info("Get memory call.");
             logger->debug("Creating SharedMemoryManager...");
             
-            if (auto target = managerMap.find(key);target == managerMap.end()) {
-                managerMap[key] = std::make_shared<SharedMemoryManager>(key, false);
-            }
             // 取共享内存管理器
-            auto manager = managerMap[key];
+            auto manager = open_manager(key);
             logger->debug("SharedMemoryManager created successfully.");
             
             // 获取共享内存的地址和大小
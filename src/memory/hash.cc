@@ -0,0 +1,97 @@
+#include "napi.h"
+#include "memory.hh"
+#include "kernels.hh"
+#include "../logger.hh"
+#include <memory>
+#include "manager.hh"
+
+namespace SharedMemory {
+    using Logger::logger;
+    Napi::Value hash_memory(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        
+        // 参数检查
+        if (info.Length() < 1) {
+            throw Napi::Error::New(env, "至少需要一个参数: key");
+        }
+        
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+        
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        
+        try {
+            logger->debug("Hash memory call.");
+            auto manager = open_manager(key);
+            size_t size = manager->get_size();
+            
+            // offset和len可省略，默认计算整个数据区
+            size_t offset = info.Length() > 1 && !info[1].IsUndefined() ? get_size_argument(info, 1, "offset") : 0;
+            if (offset > size) {
+                throw Napi::Error::New(env, "offset超出共享内存范围");
+            }
+            size_t len = info.Length() > 2 && !info[2].IsUndefined() ? get_size_argument(info, 2, "len") : size - offset;
+            if (len > size - offset) {
+                throw Napi::Error::New(env, "offset + len超出共享内存范围");
+            }
+            
+            uint32_t crc = Kernels::crc32c_parallel(manager->get_data() + offset, len);
+            logger->debug("Hash memory: key={}, offset={}, len={}, crc={:08x}", key, offset, len, crc);
+            
+            return Napi::Number::New(env, crc);
+            
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "计算共享内存校验值时发生未知错误");
+        }
+    }
+
+    Napi::Value compare_memory(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        
+        // 参数检查
+        if (info.Length() < 2) {
+            throw Napi::Error::New(env, "需要两个参数: keyA和keyB");
+        }
+        
+        if (!info[0].IsString() || !info[1].IsString()) {
+            throw Napi::Error::New(env, "参数必须是字符串类型的key");
+        }
+        
+        std::string key_a = info[0].As<Napi::String>().Utf8Value();
+        std::string key_b = info[1].As<Napi::String>().Utf8Value();
+        
+        try {
+            logger->debug("Compare memory call.");
+            auto manager_a = open_manager(key_a);
+            auto manager_b = open_manager(key_b);
+            size_t size_a = manager_a->get_size();
+            size_t size_b = manager_b->get_size();
+            size_t common = size_a < size_b ? size_a : size_b;
+            
+            size_t diff = Kernels::find_first_difference(manager_a->get_data(), manager_b->get_data(), common);
+            logger->debug("Compare memory: keyA={}, keyB={}, diff={}", key_a, key_b, diff);
+            
+            // 公共部分相同但长度不同时，较短一方的结尾即第一个不同位置
+            if (diff == common && size_a == size_b) {
+                return Napi::Number::New(env, -1);
+            }
+            return Napi::Number::New(env, static_cast<double>(diff));
+            
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "比较共享内存时发生未知错误");
+        }
+    }
+}
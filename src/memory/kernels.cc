@@ -0,0 +1,839 @@
+#include "kernels.hh"
+#include "cpu.hh"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// GCC/Clang需要为使用高级指令集的函数单独指定target，MSVC无需指定
+#if defined(__GNUC__) || defined(__clang__)
+#define KERNEL_TARGET(x) __attribute__((target(x)))
+#else
+#define KERNEL_TARGET(x)
+#endif
+
+namespace SharedMemory {
+namespace Kernels {
+
+    // CRC32C多项式（反射形式）
+    constexpr uint32_t CRC32C_POLY = 0x82F63B78;
+    // 超过该大小才拆分到多个线程
+    constexpr size_t PARALLEL_THRESHOLD = 8 * 1024 * 1024;
+    // 每个线程至少处理的数据量
+    constexpr size_t PARALLEL_MIN_CHUNK = 2 * 1024 * 1024;
+
+    static inline unsigned count_trailing_zeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+    }
+
+    /**
+     * 将[0, len)按64字节对齐拆分成若干段，第0段在当前线程执行，其余段各起一个线程
+     * 线程创建失败时，未能分配线程的段改在当前线程执行
+     * @param len 总长度
+     * @param min_chunk 每段最小长度
+     * @param fn 回调(段序号, 起始偏移, 结束偏移)
+     * @return 实际拆分的段数
+     */
+    static size_t parallel_for_chunks(size_t len, size_t min_chunk,
+        const std::function<void(size_t, size_t, size_t)>& fn) {
+        size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        size_t count = std::max<size_t>(1, std::min(hardware, len / min_chunk));
+        size_t chunk = ((len / count) + 63) & ~static_cast<size_t>(63);
+        auto run_chunk = [&](size_t i) {
+            size_t begin = std::min(len, i * chunk);
+            size_t end = i + 1 == count ? len : std::min(len, begin + chunk);
+            fn(i, begin, end);
+        };
+
+        std::vector<std::thread> workers;
+        size_t started = 1;
+        try {
+            workers.reserve(count - 1);
+            for (; started < count; started++) {
+                workers.emplace_back(run_chunk, started);
+            }
+        } catch (const std::exception&) {
+            // 线程资源不足，剩余的段在当前线程执行
+        }
+        // 无论当前线程是否抛出异常都要先等待已启动的线程，否则析构未join的线程会直接终止进程
+        try {
+            run_chunk(0);
+            for (size_t i = started; i < count; i++) {
+                run_chunk(i);
+            }
+        } catch (...) {
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            throw;
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return count;
+    }
+
+    // ---------------- CRC32C ----------------
+
+    struct Crc32cTable {
+        uint32_t table[8][256];
+    };
+
+    // slicing-by-8查表，用于不支持SSE4.2的CPU
+    static const Crc32cTable& crc32c_table() {
+        static const Crc32cTable instance = [] {
+            Crc32cTable t{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i;
+                for (int k = 0; k < 8; k++) {
+                    crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+                }
+                t.table[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; i++) {
+                for (int s = 1; s < 8; s++) {
+                    uint32_t prev = t.table[s - 1][i];
+                    t.table[s][i] = (prev >> 8) ^ t.table[0][prev & 0xFF];
+                }
+            }
+            return t;
+        }();
+        return instance;
+    }
+
+    static uint32_t crc32c_software(uint32_t crc, const uint8_t* p, size_t len) {
+        const auto& t = crc32c_table().table;
+        while (len && (reinterpret_cast<uintptr_t>(p) & 7)) {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+            len--;
+        }
+        while (len >= 8) {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            uint32_t lo = static_cast<uint32_t>(word) ^ crc;
+            uint32_t hi = static_cast<uint32_t>(word >> 32);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            len -= 8;
+        }
+        while (len--) {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+        }
+        return crc;
+    }
+
+#ifdef KERNELS_X86
+    KERNEL_TARGET("sse4.2")
+    static uint32_t crc32c_sse42(uint32_t crc, const uint8_t* p, size_t len) {
+        while (len && (reinterpret_cast<uintptr_t>(p) & 7)) {
+            crc = _mm_crc32_u8(crc, *p++);
+            len--;
+        }
+        uint64_t crc64 = crc;
+        while (len >= 8) {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+            p += 8;
+            len -= 8;
+        }
+        crc = static_cast<uint32_t>(crc64);
+        while (len--) {
+            crc = _mm_crc32_u8(crc, *p++);
+        }
+        return crc;
+    }
+#endif
+
+    uint32_t crc32c(uint32_t crc, const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        crc = ~crc;
+#ifdef KERNELS_X86
+        if (cpu_features().sse42) {
+            return ~crc32c_sse42(crc, p, len);
+        }
+#endif
+        return ~crc32c_software(crc, p, len);
+    }
+
+    static uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec) {
+        uint32_t sum = 0;
+        while (vec) {
+            if (vec & 1) {
+                sum ^= *mat;
+            }
+            vec >>= 1;
+            mat++;
+        }
+        return sum;
+    }
+
+    static void gf2_matrix_square(uint32_t* square, const uint32_t* mat) {
+        for (int n = 0; n < 32; n++) {
+            square[n] = gf2_matrix_times(mat, mat[n]);
+        }
+    }
+
+    // 与zlib的crc32_combine算法相同，仅多项式不同
+    uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2) {
+        if (len2 == 0) {
+            return crc1;
+        }
+        uint32_t even[32];
+        uint32_t odd[32];
+
+        // 表示在CRC后追加一个0比特的算子
+        odd[0] = CRC32C_POLY;
+        uint32_t row = 1;
+        for (int n = 1; n < 32; n++) {
+            odd[n] = row;
+            row <<= 1;
+        }
+        gf2_matrix_square(even, odd);   // 追加2个0比特
+        gf2_matrix_square(odd, even);   // 追加4个0比特
+
+        // 每轮平方一次，对应追加1、2、4...个0字节
+        do {
+            gf2_matrix_square(even, odd);
+            if (len2 & 1) {
+                crc1 = gf2_matrix_times(even, crc1);
+            }
+            len2 >>= 1;
+            if (len2 == 0) {
+                break;
+            }
+            gf2_matrix_square(odd, even);
+            if (len2 & 1) {
+                crc1 = gf2_matrix_times(odd, crc1);
+            }
+            len2 >>= 1;
+        } while (len2);
+
+        return crc1 ^ crc2;
+    }
+
+    uint32_t crc32c_parallel(const void* data, size_t len) {
+        if (len < PARALLEL_THRESHOLD) {
+            return crc32c(0, data, len);
+        }
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        std::vector<uint32_t> crcs(hardware, 0);
+        std::vector<size_t> lengths(hardware, 0);
+        size_t count = parallel_for_chunks(len, PARALLEL_MIN_CHUNK, [&](size_t index, size_t begin, size_t end) {
+            crcs[index] = crc32c(0, p + begin, end - begin);
+            lengths[index] = end - begin;
+        });
+
+        uint32_t crc = crcs[0];
+        for (size_t i = 1; i < count; i++) {
+            crc = crc32c_combine(crc, crcs[i], lengths[i]);
+        }
+        return crc;
+    }
+
+    // ---------------- 内存比较 ----------------
+
+    static size_t find_first_difference_scalar(const uint8_t* a, const uint8_t* b, size_t i, size_t len) {
+        for (; i + 8 <= len; i += 8) {
+            uint64_t x;
+            uint64_t y;
+            memcpy(&x, a + i, 8);
+            memcpy(&y, b + i, 8);
+            if (x != y) {
+                // 小端序下，最低的不同比特所在字节即第一个不同字节
+                return i + count_trailing_zeros(x ^ y) / 8;
+            }
+        }
+        for (; i < len; i++) {
+            if (a[i] != b[i]) {
+                return i;
+            }
+        }
+        return len;
+    }
+
+#ifdef KERNELS_X86
+    static size_t find_first_difference_sse2(const uint8_t* a, const uint8_t* b, size_t len) {
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+            if (mask != 0xFFFF) {
+                return i + count_trailing_zeros(~mask & 0xFFFF);
+            }
+        }
+        return find_first_difference_scalar(a, b, i, len);
+    }
+
+    KERNEL_TARGET("avx2")
+    static size_t find_first_difference_avx2(const uint8_t* a, const uint8_t* b, size_t len) {
+        size_t i = 0;
+        // 每轮比较64字节，两路结果合并后只做一次分支判断
+        for (; i + 64 <= len; i += 64) {
+            __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+            __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+            __m256i eq0 = _mm256_cmpeq_epi8(a0, b0);
+            __m256i eq1 = _mm256_cmpeq_epi8(a1, b1);
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(eq0, eq1))) != 0xFFFFFFFFu) {
+                uint64_t lo = static_cast<uint32_t>(_mm256_movemask_epi8(eq0));
+                uint64_t hi = static_cast<uint32_t>(_mm256_movemask_epi8(eq1));
+                return i + count_trailing_zeros(~(lo | (hi << 32)));
+            }
+        }
+        for (; i + 32 <= len; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+            if (mask != 0xFFFFFFFFu) {
+                return i + count_trailing_zeros(~static_cast<uint64_t>(mask));
+            }
+        }
+        return find_first_difference_scalar(a, b, i, len);
+    }
+#endif
+
+    size_t find_first_difference(const void* a, const void* b, size_t len) {
+        const uint8_t* pa = static_cast<const uint8_t*>(a);
+        const uint8_t* pb = static_cast<const uint8_t*>(b);
+        if (pa == pb) {
+            return len;
+        }
+#ifdef KERNELS_X86
+        if (cpu_features().avx2) {
+            return find_first_difference_avx2(pa, pb, len);
+        }
+        return find_first_difference_sse2(pa, pb, len);
+#else
+        return find_first_difference_scalar(pa, pb, 0, len);
+#endif
+    }
+
+    // ---------------- 拷贝与填充 ----------------
+
+    // 超过该大小使用非临时存储，避免大块数据把其他热数据挤出缓存
+    constexpr size_t STREAMING_THRESHOLD = 4 * 1024 * 1024;
+    // 超过该大小拆分到多个线程，单线程难以跑满内存带宽
+    constexpr size_t PARALLEL_COPY_THRESHOLD = 64 * 1024 * 1024;
+    // 拷贝时每个线程至少处理的数据量
+    constexpr size_t PARALLEL_COPY_MIN_CHUNK = 16 * 1024 * 1024;
+    // 非向量化填充时，模式成倍复制到该大小后按块重复拷贝
+    constexpr size_t FILL_BLOCK_LIMIT = 64 * 1024;
+
+#ifdef KERNELS_X86
+    // 距离下一个align对齐地址的字节数，不超过len
+    static inline size_t head_length(const uint8_t* dst, size_t align, size_t len) {
+        size_t head = (align - (reinterpret_cast<uintptr_t>(dst) & (align - 1))) & (align - 1);
+        return head < len ? head : len;
+    }
+
+    static void copy_streaming_sse2(uint8_t* dst, const uint8_t* src, size_t len) {
+        size_t i = head_length(dst, 16, len);
+        memcpy(dst, src, i);
+        for (; i + 64 <= len; i += 64) {
+            __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+            __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+            __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), v1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), v2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), v3);
+        }
+        _mm_sfence();
+        memcpy(dst + i, src + i, len - i);
+    }
+
+    KERNEL_TARGET("avx2")
+    static void copy_streaming_avx2(uint8_t* dst, const uint8_t* src, size_t len) {
+        size_t i = head_length(dst, 32, len);
+        memcpy(dst, src, i);
+        for (; i + 128 <= len; i += 128) {
+            __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+            __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+            __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v0);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), v1);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 64), v2);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 96), v3);
+        }
+        _mm_sfence();
+        memcpy(dst + i, src + i, len - i);
+    }
+
+    KERNEL_TARGET("avx512f")
+    static void copy_streaming_avx512(uint8_t* dst, const uint8_t* src, size_t len) {
+        size_t i = head_length(dst, 64, len);
+        memcpy(dst, src, i);
+        for (; i + 128 <= len; i += 128) {
+            __m512i v0 = _mm512_loadu_si512(reinterpret_cast<const void*>(src + i));
+            __m512i v1 = _mm512_loadu_si512(reinterpret_cast<const void*>(src + i + 64));
+            _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), v0);
+            _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 64), v1);
+        }
+        _mm_sfence();
+        memcpy(dst + i, src + i, len - i);
+    }
+
+    // 将64字节的模式块重复写入count次，dst需64字节对齐
+    static void store_blocks_sse2(uint8_t* dst, size_t count, const uint8_t* block, bool streaming) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+        __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+        __m128i* p = reinterpret_cast<__m128i*>(dst);
+        if (streaming) {
+            for (size_t i = 0; i < count; i++, p += 4) {
+                _mm_stream_si128(p, v0);
+                _mm_stream_si128(p + 1, v1);
+                _mm_stream_si128(p + 2, v2);
+                _mm_stream_si128(p + 3, v3);
+            }
+            _mm_sfence();
+        } else {
+            for (size_t i = 0; i < count; i++, p += 4) {
+                _mm_store_si128(p, v0);
+                _mm_store_si128(p + 1, v1);
+                _mm_store_si128(p + 2, v2);
+                _mm_store_si128(p + 3, v3);
+            }
+        }
+    }
+
+    KERNEL_TARGET("avx2")
+    static void store_blocks_avx2(uint8_t* dst, size_t count, const uint8_t* block, bool streaming) {
+        __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        __m256i* p = reinterpret_cast<__m256i*>(dst);
+        if (streaming) {
+            for (size_t i = 0; i < count; i++, p += 2) {
+                _mm256_stream_si256(p, v0);
+                _mm256_stream_si256(p + 1, v1);
+            }
+            _mm_sfence();
+        } else {
+            for (size_t i = 0; i < count; i++, p += 2) {
+                _mm256_store_si256(p, v0);
+                _mm256_store_si256(p + 1, v1);
+            }
+        }
+    }
+
+    KERNEL_TARGET("avx512f")
+    static void store_blocks_avx512(uint8_t* dst, size_t count, const uint8_t* block, bool streaming) {
+        __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(block));
+        uint8_t* p = dst;
+        if (streaming) {
+            for (size_t i = 0; i < count; i++, p += 64) {
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v);
+            }
+            _mm_sfence();
+        } else {
+            for (size_t i = 0; i < count; i++, p += 64) {
+                _mm512_store_si512(reinterpret_cast<void*>(p), v);
+            }
+        }
+    }
+#endif
+
+    static void copy_streaming(uint8_t* dst, const uint8_t* src, size_t len) {
+#ifdef KERNELS_X86
+        const CpuFeatures& features = cpu_features();
+        if (features.avx512f) {
+            copy_streaming_avx512(dst, src, len);
+        } else if (features.avx2) {
+            copy_streaming_avx2(dst, src, len);
+        } else {
+            copy_streaming_sse2(dst, src, len);
+        }
+#else
+        memcpy(dst, src, len);
+#endif
+    }
+
+    void copy(void* dst, const void* src, size_t len) {
+        uint8_t* d = static_cast<uint8_t*>(dst);
+        const uint8_t* s = static_cast<const uint8_t*>(src);
+        if (len == 0 || d == s) {
+            return;
+        }
+        uintptr_t d_addr = reinterpret_cast<uintptr_t>(d);
+        uintptr_t s_addr = reinterpret_cast<uintptr_t>(s);
+        if (d_addr < s_addr + len && s_addr < d_addr + len) {
+            memmove(d, s, len);
+            return;
+        }
+        if (len < STREAMING_THRESHOLD) {
+            memcpy(d, s, len);
+            return;
+        }
+        if (len < PARALLEL_COPY_THRESHOLD) {
+            copy_streaming(d, s, len);
+            return;
+        }
+        parallel_for_chunks(len, PARALLEL_COPY_MIN_CHUNK, [&](size_t, size_t begin, size_t end) {
+            copy_streaming(d + begin, s + begin, end - begin);
+        });
+    }
+
+    /**
+     * 填充一段内存，第j个字节为pattern[(phase + j) % pattern_len]
+     * 先写一个周期，再以已写入部分为源成倍复制
+     */
+    static void fill_replicate(uint8_t* dst, size_t len, const uint8_t* pattern, size_t pattern_len,
+        size_t phase, bool streaming) {
+        size_t filled = len < pattern_len ? len : pattern_len;
+        for (size_t j = 0; j < filled; j++) {
+            dst[j] = pattern[(phase + j) % pattern_len];
+        }
+        while (filled < len && filled < FILL_BLOCK_LIMIT) {
+            size_t n = (std::min)(filled, len - filled);
+            memcpy(dst + filled, dst, n);
+            filled += n;
+        }
+        // 此时filled是pattern_len的整数倍，按块重复即可保持周期
+        size_t block = filled;
+        while (filled < len) {
+            size_t n = (std::min)(block, len - filled);
+            if (streaming) {
+                copy_streaming(dst + filled, dst, n);
+            } else {
+                memcpy(dst + filled, dst, n);
+            }
+            filled += n;
+        }
+    }
+
+    static void fill_range(uint8_t* dst, size_t len, const uint8_t* pattern, size_t pattern_len,
+        size_t phase, bool streaming) {
+        if (pattern_len == 1 && !streaming) {
+            memset(dst, pattern[0], len);
+            return;
+        }
+#ifdef KERNELS_X86
+        // 模式长度整除64时，可以构造64字节的模式块直接用向量寄存器写入
+        if (64 % pattern_len == 0) {
+            size_t head = head_length(dst, 64, len);
+            for (size_t j = 0; j < head; j++) {
+                dst[j] = pattern[(phase + j) % pattern_len];
+            }
+            uint8_t block[64];
+            for (size_t j = 0; j < 64; j++) {
+                block[j] = pattern[(phase + head + j) % pattern_len];
+            }
+            size_t count = (len - head) / 64;
+            const CpuFeatures& features = cpu_features();
+            if (features.avx512f) {
+                store_blocks_avx512(dst + head, count, block, streaming);
+            } else if (features.avx2) {
+                store_blocks_avx2(dst + head, count, block, streaming);
+            } else {
+                store_blocks_sse2(dst + head, count, block, streaming);
+            }
+            size_t done = head + count * 64;
+            for (size_t j = done; j < len; j++) {
+                dst[j] = pattern[(phase + j) % pattern_len];
+            }
+            return;
+        }
+#endif
+        fill_replicate(dst, len, pattern, pattern_len, phase, streaming);
+    }
+
+    void fill(void* dst, size_t len, const void* pattern, size_t pattern_len) {
+        uint8_t* d = static_cast<uint8_t*>(dst);
+        const uint8_t* p = static_cast<const uint8_t*>(pattern);
+        if (len == 0 || pattern_len == 0) {
+            return;
+        }
+        if (len < PARALLEL_COPY_THRESHOLD) {
+            fill_range(d, len, p, pattern_len, 0, len >= STREAMING_THRESHOLD);
+            return;
+        }
+        parallel_for_chunks(len, PARALLEL_COPY_MIN_CHUNK, [&](size_t, size_t begin, size_t end) {
+            fill_range(d + begin, end - begin, p, pattern_len, begin % pattern_len, true);
+        });
+    }
+
+    // ---------------- 表格列运算 ----------------
+
+    // 整数累加使用int64避免溢出，浮点累加使用double
+    template <typename T>
+    using SumType = typename std::conditional<std::is_floating_point<T>::value, double, int64_t>::type;
+
+    // 无分支写法：总是写入下标，命中时才前移输出位置
+    template <typename T>
+    static size_t filter_range_scalar(const T* data, size_t begin, size_t count, T lo, T hi,
+        uint32_t* out, size_t n) {
+        for (size_t i = begin; i < count; i++) {
+            T value = data[i];
+            out[n] = static_cast<uint32_t>(i);
+            n += static_cast<size_t>((value >= lo) & (value <= hi));
+        }
+        return n;
+    }
+
+    template <typename T>
+    static void gather_scalar(const T* data, const uint32_t* indices, size_t begin, size_t count, T* out) {
+        for (size_t i = begin; i < count; i++) {
+            out[i] = data[indices[i]];
+        }
+    }
+
+    template <typename T>
+    static ColumnStats aggregate_scalar(const T* data, size_t count) {
+        T lo = data[0];
+        T hi = data[0];
+        SumType<T> sum = 0;
+        for (size_t i = 0; i < count; i++) {
+            T value = data[i];
+            lo = value < lo ? value : lo;
+            hi = value > hi ? value : hi;
+            sum += value;
+        }
+        return ColumnStats{static_cast<double>(lo), static_cast<double>(hi), static_cast<double>(sum)};
+    }
+
+#ifdef KERNELS_X86
+    // 将8位比较掩码中的命中位置展开为下标
+    static inline size_t emit_mask_indices(unsigned mask, size_t base, uint32_t* out, size_t n) {
+        while (mask) {
+            out[n++] = static_cast<uint32_t>(base + count_trailing_zeros(mask));
+            mask &= mask - 1;
+        }
+        return n;
+    }
+
+    KERNEL_TARGET("avx2")
+    static size_t filter_range_f32_avx2(const float* data, size_t count, float lo, float hi, uint32_t* out) {
+        __m256 vlo = _mm256_set1_ps(lo);
+        __m256 vhi = _mm256_set1_ps(hi);
+        size_t n = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 v = _mm256_loadu_ps(data + i);
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(v, vlo, _CMP_GE_OQ), _mm256_cmp_ps(v, vhi, _CMP_LE_OQ));
+            n = emit_mask_indices(static_cast<unsigned>(_mm256_movemask_ps(hit)), i, out, n);
+        }
+        return filter_range_scalar(data, i, count, lo, hi, out, n);
+    }
+
+    KERNEL_TARGET("avx2")
+    static size_t filter_range_i32_avx2(const int32_t* data, size_t count, int32_t lo, int32_t hi, uint32_t* out) {
+        __m256i vlo = _mm256_set1_epi32(lo);
+        __m256i vhi = _mm256_set1_epi32(hi);
+        size_t n = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            // 小于下界或大于上界即未命中
+            __m256i miss = _mm256_or_si256(_mm256_cmpgt_epi32(vlo, v), _mm256_cmpgt_epi32(v, vhi));
+            unsigned mask = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(miss))) & 0xFF;
+            n = emit_mask_indices(mask, i, out, n);
+        }
+        return filter_range_scalar(data, i, count, lo, hi, out, n);
+    }
+
+    // 4字节元素的硬件gather，下标需小于2^31
+    KERNEL_TARGET("avx2")
+    static void gather_32_avx2(const int32_t* data, const uint32_t* indices, size_t count, int32_t* out) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            __m256i value = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data), index, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+        }
+        gather_scalar(data, indices, i, count, out);
+    }
+
+    KERNEL_TARGET("avx2")
+    static ColumnStats aggregate_f32_avx2(const float* data, size_t count) {
+        if (count < 8) {
+            return aggregate_scalar(data, count);
+        }
+        __m256 vmin = _mm256_loadu_ps(data);
+        __m256 vmax = vmin;
+        __m256d sum0 = _mm256_setzero_pd();
+        __m256d sum1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 v = _mm256_loadu_ps(data + i);
+            vmin = _mm256_min_ps(vmin, v);
+            vmax = _mm256_max_ps(vmax, v);
+            sum0 = _mm256_add_pd(sum0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+            sum1 = _mm256_add_pd(sum1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        }
+        float mins[8];
+        float maxs[8];
+        double sums[4];
+        _mm256_storeu_ps(mins, vmin);
+        _mm256_storeu_ps(maxs, vmax);
+        _mm256_storeu_pd(sums, _mm256_add_pd(sum0, sum1));
+        ColumnStats stats{mins[0], maxs[0], sums[0] + sums[1] + sums[2] + sums[3]};
+        for (int k = 1; k < 8; k++) {
+            stats.min = mins[k] < stats.min ? mins[k] : stats.min;
+            stats.max = maxs[k] > stats.max ? maxs[k] : stats.max;
+        }
+        if (i < count) {
+            ColumnStats tail = aggregate_scalar(data + i, count - i);
+            stats.min = tail.min < stats.min ? tail.min : stats.min;
+            stats.max = tail.max > stats.max ? tail.max : stats.max;
+            stats.sum += tail.sum;
+        }
+        return stats;
+    }
+
+    KERNEL_TARGET("avx2")
+    static ColumnStats aggregate_i32_avx2(const int32_t* data, size_t count) {
+        if (count < 8) {
+            return aggregate_scalar(data, count);
+        }
+        __m256i vmin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i vmax = vmin;
+        __m256i sum = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            vmin = _mm256_min_epi32(vmin, v);
+            vmax = _mm256_max_epi32(vmax, v);
+            sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        int32_t mins[8];
+        int32_t maxs[8];
+        int64_t sums[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(mins), vmin);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum);
+        int32_t lo = mins[0];
+        int32_t hi = maxs[0];
+        for (int k = 1; k < 8; k++) {
+            lo = mins[k] < lo ? mins[k] : lo;
+            hi = maxs[k] > hi ? maxs[k] : hi;
+        }
+        int64_t total = sums[0] + sums[1] + sums[2] + sums[3];
+        for (; i < count; i++) {
+            lo = data[i] < lo ? data[i] : lo;
+            hi = data[i] > hi ? data[i] : hi;
+            total += data[i];
+        }
+        return ColumnStats{static_cast<double>(lo), static_cast<double>(hi), static_cast<double>(total)};
+    }
+#endif
+
+    template <typename T>
+    size_t filter_range(const T* data, size_t count, T lo, T hi, uint32_t* out) {
+        return filter_range_scalar(data, 0, count, lo, hi, out, 0);
+    }
+
+    template <>
+    size_t filter_range<float>(const float* data, size_t count, float lo, float hi, uint32_t* out) {
+#ifdef KERNELS_X86
+        if (cpu_features().avx2) {
+            return filter_range_f32_avx2(data, count, lo, hi, out);
+        }
+#endif
+        return filter_range_scalar(data, 0, count, lo, hi, out, 0);
+    }
+
+    template <>
+    size_t filter_range<int32_t>(const int32_t* data, size_t count, int32_t lo, int32_t hi, uint32_t* out) {
+#ifdef KERNELS_X86
+        if (cpu_features().avx2) {
+            return filter_range_i32_avx2(data, count, lo, hi, out);
+        }
+#endif
+        return filter_range_scalar(data, 0, count, lo, hi, out, 0);
+    }
+
+    template <typename T>
+    void gather(const T* data, const uint32_t* indices, size_t count, T* out) {
+#ifdef KERNELS_X86
+        // 4字节元素按位拷贝即可，与具体类型无关
+        if (sizeof(T) == 4 && cpu_features().avx2) {
+            gather_32_avx2(reinterpret_cast<const int32_t*>(data), indices, count, reinterpret_cast<int32_t*>(out));
+            return;
+        }
+#endif
+        gather_scalar(data, indices, 0, count, out);
+    }
+
+    template <typename T>
+    ColumnStats aggregate(const T* data, size_t count) {
+        return aggregate_scalar(data, count);
+    }
+
+    template <>
+    ColumnStats aggregate<float>(const float* data, size_t count) {
+#ifdef KERNELS_X86
+        if (cpu_features().avx2) {
+            return aggregate_f32_avx2(data, count);
+        }
+#endif
+        return aggregate_scalar(data, count);
+    }
+
+    template <>
+    ColumnStats aggregate<int32_t>(const int32_t* data, size_t count) {
+#ifdef KERNELS_X86
+        if (cpu_features().avx2) {
+            return aggregate_i32_avx2(data, count);
+        }
+#endif
+        return aggregate_scalar(data, count);
+    }
+
+    // 为表格支持的所有列类型显式实例化
+#define KERNELS_INSTANTIATE_FILTER(T) \
+    template size_t filter_range<T>(const T*, size_t, T, T, uint32_t*);
+#define KERNELS_INSTANTIATE_GATHER(T) \
+    template void gather<T>(const T*, const uint32_t*, size_t, T*);
+#define KERNELS_INSTANTIATE_AGGREGATE(T) \
+    template ColumnStats aggregate<T>(const T*, size_t);
+
+    KERNELS_INSTANTIATE_FILTER(int8_t)
+    KERNELS_INSTANTIATE_FILTER(uint8_t)
+    KERNELS_INSTANTIATE_FILTER(int16_t)
+    KERNELS_INSTANTIATE_FILTER(uint16_t)
+    KERNELS_INSTANTIATE_FILTER(uint32_t)
+    KERNELS_INSTANTIATE_FILTER(double)
+
+    KERNELS_INSTANTIATE_GATHER(int8_t)
+    KERNELS_INSTANTIATE_GATHER(uint8_t)
+    KERNELS_INSTANTIATE_GATHER(int16_t)
+    KERNELS_INSTANTIATE_GATHER(uint16_t)
+    KERNELS_INSTANTIATE_GATHER(int32_t)
+    KERNELS_INSTANTIATE_GATHER(uint32_t)
+    KERNELS_INSTANTIATE_GATHER(float)
+    KERNELS_INSTANTIATE_GATHER(double)
+
+    KERNELS_INSTANTIATE_AGGREGATE(int8_t)
+    KERNELS_INSTANTIATE_AGGREGATE(uint8_t)
+    KERNELS_INSTANTIATE_AGGREGATE(int16_t)
+    KERNELS_INSTANTIATE_AGGREGATE(uint16_t)
+    KERNELS_INSTANTIATE_AGGREGATE(uint32_t)
+    KERNELS_INSTANTIATE_AGGREGATE(double)
+}
+}
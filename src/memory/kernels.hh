@@ -0,0 +1,114 @@
+#pragma once
+
+#ifndef __KERNELS_HH__
+#define __KERNELS_HH__
+#include <cstddef>
+#include <cstdint>
+
+namespace SharedMemory {
+namespace Kernels {
+
+    /**
+     * 计算CRC32C（Castagnoli）校验值，支持SSE4.2时使用硬件指令
+     * @param crc 之前数据的校验值，首段传0
+     * @param data 数据地址
+     * @param len 数据长度
+     * @return 追加data后的校验值
+     */
+    uint32_t crc32c(uint32_t crc, const void* data, size_t len);
+
+    /**
+     * 合并两段相邻数据的CRC32C
+     * @param crc1 前一段的校验值
+     * @param crc2 后一段的校验值
+     * @param len2 后一段的长度
+     * @return 两段拼接后的校验值
+     */
+    uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+    /**
+     * 计算CRC32C，大块数据分段后多线程计算再合并，结果与crc32c(0, data, len)一致
+     * @param data 数据地址
+     * @param len 数据长度
+     * @return 校验值
+     */
+    uint32_t crc32c_parallel(const void* data, size_t len);
+
+    /**
+     * 查找两段内存中第一个不同字节的位置
+     * @param a 第一段内存
+     * @param b 第二段内存
+     * @param len 比较长度
+     * @return 第一个不同字节的偏移，完全相同时返回len
+     */
+    size_t find_first_difference(const void* a, const void* b, size_t len);
+
+    /**
+     * 内存拷贝，大块数据使用非临时存储（绕过缓存）并拆分到多个线程，区域重叠时退化为memmove
+     * @param dst 目标地址
+     * @param src 源地址
+     * @param len 拷贝长度
+     */
+    void copy(void* dst, const void* src, size_t len);
+
+    /**
+     * 用重复的模式填充内存，大块数据使用非临时存储并拆分到多个线程
+     * @param dst 目标地址
+     * @param len 填充长度
+     * @param pattern 模式数据
+     * @param pattern_len 模式长度，不能为0
+     */
+    void fill(void* dst, size_t len, const void* pattern, size_t pattern_len);
+
+    /**
+     * 筛选出值在[lo, hi]范围内的元素下标
+     * @param data 列数据
+     * @param count 元素个数
+     * @param lo 下界（含）
+     * @param hi 上界（含）
+     * @param out 输出下标，容量不小于count
+     * @return 命中的元素个数
+     */
+    template <typename T>
+    size_t filter_range(const T* data, size_t count, T lo, T hi, uint32_t* out);
+
+    // float32与int32有AVX2实现，定义在kernels.cc
+    template <>
+    size_t filter_range<float>(const float* data, size_t count, float lo, float hi, uint32_t* out);
+    template <>
+    size_t filter_range<int32_t>(const int32_t* data, size_t count, int32_t lo, int32_t hi, uint32_t* out);
+
+    /**
+     * 按下标列表收集元素，调用方需保证下标不越界
+     * @param data 列数据
+     * @param indices 下标列表
+     * @param count 下标个数
+     * @param out 输出，容量不小于count
+     */
+    template <typename T>
+    void gather(const T* data, const uint32_t* indices, size_t count, T* out);
+
+    // 列统计结果
+    struct ColumnStats {
+        double min;
+        double max;
+        double sum;
+    };
+
+    /**
+     * 计算最小值、最大值与总和，count为0时结果未定义
+     * @param data 列数据
+     * @param count 元素个数
+     * @return 统计结果
+     */
+    template <typename T>
+    ColumnStats aggregate(const T* data, size_t count);
+
+    // float32与int32有AVX2实现，定义在kernels.cc
+    template <>
+    ColumnStats aggregate<float>(const float* data, size_t count);
+    template <>
+    ColumnStats aggregate<int32_t>(const int32_t* data, size_t count);
+}
+}
+#endif
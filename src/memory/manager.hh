@@ -36,6 +36,9 @@ namespace SharedMemory {
         // 获取共享内存地址
         void* get_address() const { return address_; }
         
+        // 获取数据区地址（跳过头部）
+        char* get_data() const { return static_cast<char*>(address_) + sizeof(SharedMemoryHeader); }
+        
         // 获取共享内存大小
         size_t get_size() const { return size_; }
         
@@ -40,5 +40,119 @@ namespace SharedMemory {
      * @return 是否成功
      */
     Napi::Boolean remove_memory(const Napi::CallbackInfo &info);
+
+    /**
+     * 获取已打开的共享内存管理器，不存在时打开已有的共享内存
+     * @param key 共享内存键名
+     * @return 共享内存管理器
+     */
+    std::shared_ptr<SharedMemoryManager> open_manager(const std::string &key);
+
+    /**
+     * 读取非负整数类型的参数（偏移、长度等）
+     * @param info 回调信息
+     * @param index 参数位置
+     * @param name 参数名，用于错误提示
+     * @return 参数值
+     */
+    size_t get_size_argument(const Napi::CallbackInfo &info, size_t index, const char *name);
+
+    /**
+     * 计算共享内存指定范围的CRC32C校验值
+     * @param info 回调信息
+     * @return 校验值
+     */
+    Napi::Value hash_memory(const Napi::CallbackInfo &info);
+
+    /**
+     * 比较两块共享内存
+     * @param info 回调信息
+     * @return 第一个不同字节的偏移，完全相同时返回-1
+     */
+    Napi::Value compare_memory(const Napi::CallbackInfo &info);
+
+    /**
+     * 异步读取文件到共享内存
+     * @param info 回调信息
+     * @return Promise，完成时返回读取的字节数
+     */
+    Napi::Value read_file_into(const Napi::CallbackInfo &info);
+
+    /**
+     * 异步将共享内存写出到文件
+     * @param info 回调信息
+     * @return Promise，完成时返回写入的字节数
+     */
+    Napi::Value write_file_from(const Napi::CallbackInfo &info);
+
+    /**
+     * 将JS二进制数据拷贝到共享内存
+     * @param info 回调信息
+     * @return 拷贝的字节数
+     */
+    Napi::Value copy_into_memory(const Napi::CallbackInfo &info);
+
+    /**
+     * 在两块共享内存之间拷贝数据
+     * @param info 回调信息
+     * @return 拷贝的字节数
+     */
+    Napi::Value copy_between(const Napi::CallbackInfo &info);
+
+    /**
+     * 用重复的模式填充共享内存
+     * @param info 回调信息
+     * @return 填充的字节数
+     */
+    Napi::Value fill_memory(const Napi::CallbackInfo &info);
+
+    /**
+     * 创建按列存放的表格共享内存
+     * @param info 回调信息
+     * @return 表格对象，包含容量和每列的TypedArray视图
+     */
+    Napi::Value create_table(const Napi::CallbackInfo &info);
+
+    /**
+     * 打开已有的表格共享内存
+     * @param info 回调信息
+     * @return 表格对象，包含容量和每列的TypedArray视图
+     */
+    Napi::Value open_table(const Napi::CallbackInfo &info);
+
+    /**
+     * 获取表格当前有效行数
+     * @param info 回调信息
+     * @return 行数
+     */
+    Napi::Value get_table_row_count(const Napi::CallbackInfo &info);
+
+    /**
+     * 设置表格当前有效行数
+     * @param info 回调信息
+     * @return 行数
+     */
+    Napi::Value set_table_row_count(const Napi::CallbackInfo &info);
+
+    /**
+     * 筛选某列值在[min, max]范围内的行
+     * @param info 回调信息
+     * @return 命中行下标的Uint32Array
+     */
+    Napi::Value table_filter_range(const Napi::CallbackInfo &info);
+
+    /**
+     * 按下标列表收集某列的值
+     * @param info 回调信息
+     * @return 与列类型相同的TypedArray
+     */
+    Napi::Value table_gather(const Napi::CallbackInfo &info);
+
+    /**
+     * 统计某列的最小值、最大值与总和
+     * @param info 回调信息
+     * @return {count, min, max, sum}
+     */
+    Napi::Value table_aggregate(const Napi::CallbackInfo &info);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include "napi.h"
+#include "memory.hh"
+#include "table.hh"
+#include "kernels.hh"
+#include "../logger.hh"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "manager.hh"
+
+namespace SharedMemory {
+    using Logger::logger;
+
+    // 行数上限，保证下标可以用uint32表示且能用于AVX2 gather
+    constexpr uint64_t TABLE_MAX_ROWS = 0x7FFFFFFF;
+
+    template <typename T>
+    struct TypeTag {
+        using type = T;
+    };
+
+    // 按列类型调用fn(TypeTag<T>)
+    template <typename F>
+    static auto dispatch_column_type(ColumnType type, F&& fn) {
+        switch (type) {
+            case ColumnType::Int8: return fn(TypeTag<int8_t>());
+            case ColumnType::Uint8: return fn(TypeTag<uint8_t>());
+            case ColumnType::Int16: return fn(TypeTag<int16_t>());
+            case ColumnType::Uint16: return fn(TypeTag<uint16_t>());
+            case ColumnType::Int32: return fn(TypeTag<int32_t>());
+            case ColumnType::Uint32: return fn(TypeTag<uint32_t>());
+            case ColumnType::Float32: return fn(TypeTag<float>());
+            case ColumnType::Float64: return fn(TypeTag<double>());
+        }
+        throw std::runtime_error("未知的列类型");
+    }
+
+    // 解析列类型名称
+    static bool parse_column_type(const std::string& name, ColumnType& type) {
+        static const struct {
+            const char* name;
+            ColumnType type;
+        } types[] = {
+            {"int8", ColumnType::Int8},
+            {"uint8", ColumnType::Uint8},
+            {"int16", ColumnType::Int16},
+            {"uint16", ColumnType::Uint16},
+            {"int32", ColumnType::Int32},
+            {"uint32", ColumnType::Uint32},
+            {"float32", ColumnType::Float32},
+            {"float64", ColumnType::Float64},
+        };
+        for (const auto& item : types) {
+            if (name == item.name) {
+                type = item.type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 获取表格头部，并校验共享内存确实是表格
+    static TableHeader* get_table_header(Napi::Env env, const std::shared_ptr<SharedMemoryManager>& manager) {
+        if (manager->get_size() < sizeof(TableHeader)) {
+            throw Napi::Error::New(env, "共享内存不是表格类型");
+        }
+        TableHeader* header = reinterpret_cast<TableHeader*>(manager->get_data());
+        if (header->magic != TABLE_MAGIC) {
+            throw Napi::Error::New(env, "共享内存不是表格类型");
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->version != TABLE_VERSION) {
+            throw Napi::Error::New(env, "不支持的表格版本");
+        }
+        // 头部来自共享内存，可能已被其他进程按更大的容量重建或已损坏，校验布局后才能用于原生扫描
+        size_t size = manager->get_size();
+        uint64_t capacity = header->row_capacity;
+        bool valid = header->column_count >= 1 && header->column_count <= TABLE_MAX_COLUMNS &&
+            capacity <= TABLE_MAX_ROWS;
+        for (uint32_t i = 0; valid && i < header->column_count; i++) {
+            const TableColumn& column = header->columns[i];
+            valid = column.type <= static_cast<uint32_t>(ColumnType::Float64) &&
+                memchr(column.name, 0, TABLE_COLUMN_NAME_SIZE) != nullptr;
+            if (!valid) {
+                break;
+            }
+            uint32_t element_size = dispatch_column_type(static_cast<ColumnType>(column.type), [](auto tag) {
+                return static_cast<uint32_t>(sizeof(typename decltype(tag)::type));
+            });
+            valid = column.element_size == element_size &&
+                column.offset >= sizeof(TableHeader) &&
+                column.offset % element_size == 0 &&
+                column.offset <= size &&
+                element_size * capacity <= size - column.offset;
+        }
+        if (!valid) {
+            throw Napi::Error::New(env, "表格布局超出共享内存范围");
+        }
+        return header;
+    }
+
+    // 按列名或列序号查找列
+    static const TableColumn& find_column(Napi::Env env, const TableHeader* header, const Napi::Value& value) {
+        if (value.IsNumber()) {
+            int64_t index = value.As<Napi::Number>().Int64Value();
+            if (index < 0 || index >= static_cast<int64_t>(header->column_count)) {
+                throw Napi::Error::New(env, "列序号超出范围");
+            }
+            return header->columns[index];
+        }
+        if (value.IsString()) {
+            std::string name = value.As<Napi::String>().Utf8Value();
+            for (uint32_t i = 0; i < header->column_count; i++) {
+                if (name == header->columns[i].name) {
+                    return header->columns[i];
+                }
+            }
+            throw Napi::Error::New(env, "列不存在: " + name);
+        }
+        throw Napi::Error::New(env, "列参数必须是列名或列序号");
+    }
+
+    // 当前有效行数，不超过容量
+    static size_t get_row_count(const TableHeader* header) {
+        uint64_t rows = header->row_count.load(std::memory_order_acquire);
+        return static_cast<size_t>(rows < header->row_capacity ? rows : header->row_capacity);
+    }
+
+    // 将JS数值范围转换为列类型的闭区间，区间为空时返回false
+    template <typename T>
+    static bool to_column_range(double min, double max, T& lo, T& hi) {
+        if (std::isnan(min) || std::isnan(max)) {
+            return false;
+        }
+        if constexpr (std::is_floating_point<T>::value) {
+            // 超出float范围的界限按无穷处理
+            constexpr T infinity = std::numeric_limits<T>::infinity();
+            double type_max = static_cast<double>(std::numeric_limits<T>::max());
+            lo = min < -type_max ? -infinity : min > type_max ? infinity : static_cast<T>(min);
+            hi = max > type_max ? infinity : max < -type_max ? -infinity : static_cast<T>(max);
+            // 转换为float时按最近值舍入，有限的下界需向上、上界需向下取到可表示的值，与JS中按double比较的结果一致
+            if (std::isfinite(lo) && static_cast<double>(lo) < min) {
+                lo = std::nextafter(lo, infinity);
+            }
+            if (std::isfinite(hi) && static_cast<double>(hi) > max) {
+                hi = std::nextafter(hi, -infinity);
+            }
+            return lo <= hi;
+        }
+        // 整数列：下界向上取整、上界向下取整后截断到类型范围
+        double type_min = static_cast<double>(std::numeric_limits<T>::min());
+        double type_max = static_cast<double>(std::numeric_limits<T>::max());
+        min = std::ceil(min);
+        max = std::floor(max);
+        if (min > max || min > type_max || max < type_min) {
+            return false;
+        }
+        lo = static_cast<T>(min < type_min ? type_min : min);
+        hi = static_cast<T>(max > type_max ? type_max : max);
+        return true;
+    }
+
+    // 构造描述表格的JS对象，每列是直接映射到共享内存的TypedArray
+    static Napi::Object make_table_object(Napi::Env env, const std::shared_ptr<SharedMemoryManager>& manager,
+        TableHeader* header) {
+        auto deleter = [](void* /*data*/, void* /*hint*/) {
+            logger->debug("Table buffer cleanup callback called.");
+        };
+        auto buffer = Napi::ArrayBuffer::New(env, manager->get_data(), manager->get_size(), deleter);
+
+        Napi::Object columns = Napi::Object::New(env);
+        for (uint32_t i = 0; i < header->column_count; i++) {
+            const TableColumn& column = header->columns[i];
+            size_t capacity = static_cast<size_t>(header->row_capacity);
+            Napi::Value view = dispatch_column_type(static_cast<ColumnType>(column.type), [&](auto tag) -> Napi::Value {
+                using T = typename decltype(tag)::type;
+                return Napi::TypedArrayOf<T>::New(env, capacity, buffer, static_cast<size_t>(column.offset));
+            });
+            columns.Set(column.name, view);
+        }
+
+        Napi::Object table = Napi::Object::New(env);
+        table.Set("capacity", Napi::Number::New(env, static_cast<double>(header->row_capacity)));
+        table.Set("columns", columns);
+        return table;
+    }
+
+    Napi::Value create_table(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 3) {
+            throw Napi::Error::New(env, "需要三个参数: key、schema和capacity");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        if (!info[1].IsArray()) {
+            throw Napi::Error::New(env, "第二个参数必须是列描述数组schema");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        Napi::Array schema = info[1].As<Napi::Array>();
+        size_t capacity = get_size_argument(info, 2, "capacity");
+
+        if (schema.Length() == 0 || schema.Length() > TABLE_MAX_COLUMNS) {
+            throw Napi::Error::New(env, "列数必须在1到" + std::to_string(TABLE_MAX_COLUMNS) + "之间");
+        }
+        if (capacity == 0 || capacity > TABLE_MAX_ROWS) {
+            throw Napi::Error::New(env, "capacity必须大于0且不超过" + std::to_string(TABLE_MAX_ROWS));
+        }
+
+        // 解析列描述并计算布局，每列的绝对地址按TABLE_COLUMN_ALIGNMENT对齐
+        std::vector<TableColumn> columns(schema.Length());
+        size_t cursor = sizeof(SharedMemoryHeader) + sizeof(TableHeader);
+        for (uint32_t i = 0; i < schema.Length(); i++) {
+            Napi::Value item = schema.Get(i);
+            if (!item.IsObject()) {
+                throw Napi::Error::New(env, "列描述必须是{name, type}对象");
+            }
+            Napi::Object descriptor = item.As<Napi::Object>();
+            Napi::Value name = descriptor.Get("name");
+            Napi::Value type = descriptor.Get("type");
+            if (!name.IsString() || !type.IsString()) {
+                throw Napi::Error::New(env, "列描述的name和type必须是字符串");
+            }
+
+            std::string column_name = name.As<Napi::String>().Utf8Value();
+            if (column_name.empty() || column_name.size() >= TABLE_COLUMN_NAME_SIZE) {
+                throw Napi::Error::New(env, "列名长度必须在1到" + std::to_string(TABLE_COLUMN_NAME_SIZE - 1) + "字节之间");
+            }
+            for (uint32_t j = 0; j < i; j++) {
+                if (column_name == columns[j].name) {
+                    throw Napi::Error::New(env, "列名重复: " + column_name);
+                }
+            }
+            ColumnType column_type;
+            if (!parse_column_type(type.As<Napi::String>().Utf8Value(), column_type)) {
+                throw Napi::Error::New(env, "不支持的列类型: " + type.As<Napi::String>().Utf8Value());
+            }
+
+            TableColumn& column = columns[i];
+            memset(&column, 0, sizeof(column));
+            memcpy(column.name, column_name.c_str(), column_name.size());
+            column.type = static_cast<uint32_t>(column_type);
+            column.element_size = dispatch_column_type(column_type, [](auto tag) {
+                return static_cast<uint32_t>(sizeof(typename decltype(tag)::type));
+            });
+            cursor = (cursor + TABLE_COLUMN_ALIGNMENT - 1) & ~(TABLE_COLUMN_ALIGNMENT - 1);
+            column.offset = cursor - sizeof(SharedMemoryHeader);
+            cursor += column.element_size * capacity;
+        }
+        size_t length = cursor - sizeof(SharedMemoryHeader);
+
+        try {
+            logger->debug("Create table call: key={}, columns={}, capacity={}, size={}", key, columns.size(), capacity, length);
+
+            // 创建共享内存管理器
+            auto manager = managerMap[key] = std::make_shared<SharedMemoryManager>(key, true, length);
+
+            // 重置头部（magic随之清零），在发布magic之前清零列数据，同一key复用时可能残留旧数据
+            TableHeader* header = new (manager->get_data()) TableHeader();
+            memset(manager->get_data() + sizeof(TableHeader), 0, length - sizeof(TableHeader));
+            header->version = TABLE_VERSION;
+            header->column_count = static_cast<uint32_t>(columns.size());
+            header->row_capacity = capacity;
+            header->row_count.store(0, std::memory_order_relaxed);
+            memcpy(header->columns, columns.data(), columns.size() * sizeof(TableColumn));
+            // magic最后写入，其他进程看到magic时布局已经完整
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = TABLE_MAGIC;
+
+            return make_table_object(env, manager, header);
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "创建表格时发生未知错误");
+        }
+    }
+
+    Napi::Value open_table(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 1) {
+            throw Napi::Error::New(env, "需要一个参数: key");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "参数必须是字符串类型的key");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        try {
+            logger->debug("Open table call: key={}", key);
+            auto manager = open_manager(key);
+            TableHeader* header = get_table_header(env, manager);
+            return make_table_object(env, manager, header);
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "打开表格时发生未知错误");
+        }
+    }
+
+    Napi::Value get_table_row_count(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::Error::New(env, "参数必须是字符串类型的key");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        try {
+            TableHeader* header = get_table_header(env, open_manager(key));
+            return Napi::Number::New(env, static_cast<double>(get_row_count(header)));
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "获取表格行数时发生未知错误");
+        }
+    }
+
+    Napi::Value set_table_row_count(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 2) {
+            throw Napi::Error::New(env, "需要两个参数: key和rowCount");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        size_t rows = get_size_argument(info, 1, "rowCount");
+
+        try {
+            TableHeader* header = get_table_header(env, open_manager(key));
+            if (rows > header->row_capacity) {
+                throw Napi::Error::New(env, "rowCount超出表格容量");
+            }
+            // release保证其他进程读到新行数时也能看到之前写入的行数据
+            header->row_count.store(rows, std::memory_order_release);
+            return Napi::Number::New(env, static_cast<double>(rows));
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "设置表格行数时发生未知错误");
+        }
+    }
+
+    Napi::Value table_filter_range(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 4) {
+            throw Napi::Error::New(env, "需要四个参数: key、column、min和max");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        if (!info[2].IsNumber() || !info[3].IsNumber()) {
+            throw Napi::Error::New(env, "min和max必须是数字类型");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+        double min = info[2].As<Napi::Number>().DoubleValue();
+        double max = info[3].As<Napi::Number>().DoubleValue();
+
+        try {
+            auto manager = open_manager(key);
+            TableHeader* header = get_table_header(env, manager);
+            const TableColumn& column = find_column(env, header, info[1]);
+            size_t rows = get_row_count(header);
+            const char* data = manager->get_data() + column.offset;
+
+            // 先扫描进复用的本地缓冲区，再按命中数分配结果，避免每次查询都在JS堆上分配整列大小的数组
+            thread_local std::vector<uint32_t> scratch;
+            return dispatch_column_type(static_cast<ColumnType>(column.type), [&](auto tag) -> Napi::Value {
+                using T = typename decltype(tag)::type;
+                T lo;
+                T hi;
+                if (rows == 0 || !to_column_range(min, max, lo, hi)) {
+                    return Napi::Uint32Array::New(env, 0);
+                }
+                if (scratch.size() < rows) {
+                    scratch.resize(rows);
+                }
+                size_t count = Kernels::filter_range(reinterpret_cast<const T*>(data), rows, lo, hi, scratch.data());
+                logger->debug("Table filter range: key={}, column={}, rows={}, matched={}", key, column.name, rows, count);
+                auto result = Napi::Uint32Array::New(env, count);
+                if (count) {
+                    memcpy(result.Data(), scratch.data(), count * sizeof(uint32_t));
+                }
+                return result;
+            });
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "筛选表格时发生未知错误");
+        }
+    }
+
+    Napi::Value table_gather(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 3) {
+            throw Napi::Error::New(env, "需要三个参数: key、column和indices");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        // indices可以是Uint32Array或数字数组，统一复制到本地，Uint32Array可能映射在其他进程可写的共享内存上，
+        // 校验后若再从原数组读取，下标可能已被改写而越界
+        std::vector<uint32_t> index_copy;
+        if (info[2].IsTypedArray() && info[2].As<Napi::TypedArray>().TypedArrayType() == napi_uint32_array) {
+            Napi::Uint32Array array = info[2].As<Napi::Uint32Array>();
+            index_copy.assign(array.Data(), array.Data() + array.ElementLength());
+        } else if (info[2].IsArray()) {
+            Napi::Array array = info[2].As<Napi::Array>();
+            index_copy.resize(array.Length());
+            for (uint32_t i = 0; i < array.Length(); i++) {
+                Napi::Value value = array.Get(i);
+                int64_t index = value.IsNumber() ? value.As<Napi::Number>().Int64Value() : -1;
+                if (index < 0 || index > 0xFFFFFFFFll) {
+                    throw Napi::Error::New(env, "indices必须是uint32范围内的非负整数");
+                }
+                index_copy[i] = static_cast<uint32_t>(index);
+            }
+        } else {
+            throw Napi::Error::New(env, "indices必须是Uint32Array或数字数组");
+        }
+
+        try {
+            auto manager = open_manager(key);
+            TableHeader* header = get_table_header(env, manager);
+            const TableColumn& column = find_column(env, header, info[1]);
+            size_t rows = get_row_count(header);
+            const char* data = manager->get_data() + column.offset;
+            const uint32_t* indices = index_copy.data();
+            size_t count = index_copy.size();
+
+            // 先用向量化的统计找出最大下标，一次性完成越界检查
+            if (count && Kernels::aggregate(indices, count).max >= static_cast<double>(rows)) {
+                throw Napi::Error::New(env, "indices中的下标超出有效行数");
+            }
+
+            return dispatch_column_type(static_cast<ColumnType>(column.type), [&](auto tag) -> Napi::Value {
+                using T = typename decltype(tag)::type;
+                auto result = Napi::TypedArrayOf<T>::New(env, count);
+                if (count) {
+                    Kernels::gather(reinterpret_cast<const T*>(data), indices, count, result.Data());
+                }
+                return result;
+            });
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "收集表格数据时发生未知错误");
+        }
+    }
+
+    Napi::Value table_aggregate(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+
+        // 参数检查
+        if (info.Length() < 2) {
+            throw Napi::Error::New(env, "需要两个参数: key和column");
+        }
+
+        if (!info[0].IsString()) {
+            throw Napi::Error::New(env, "第一个参数必须是字符串类型的key");
+        }
+
+        std::string key = info[0].As<Napi::String>().Utf8Value();
+
+        try {
+            auto manager = open_manager(key);
+            TableHeader* header = get_table_header(env, manager);
+            const TableColumn& column = find_column(env, header, info[1]);
+            size_t rows = get_row_count(header);
+            const char* data = manager->get_data() + column.offset;
+
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("count", Napi::Number::New(env, static_cast<double>(rows)));
+            result.Set("sum", Napi::Number::New(env, 0));
+            // 没有有效行时不返回min和max
+            if (rows == 0) {
+                return result;
+            }
+
+            Kernels::ColumnStats stats = dispatch_column_type(static_cast<ColumnType>(column.type), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+                return Kernels::aggregate(reinterpret_cast<const T*>(data), rows);
+            });
+            result.Set("min", Napi::Number::New(env, stats.min));
+            result.Set("max", Napi::Number::New(env, stats.max));
+            result.Set("sum", Napi::Number::New(env, stats.sum));
+            return result;
+
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            logger->debug("Error: {}", e.what());
+            throw Napi::Error::New(env, e.what());
+        } catch (...) {
+            logger->debug("Unknown error occurred");
+            throw Napi::Error::New(env, "统计表格数据时发生未知错误");
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef __TABLE_HH__
+#define __TABLE_HH__
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SharedMemory {
+
+    constexpr uint32_t TABLE_MAGIC = 0x4C425453;        // "STBL"
+    constexpr uint32_t TABLE_VERSION = 1;
+    constexpr size_t TABLE_MAX_COLUMNS = 64;            // 最大列数
+    constexpr size_t TABLE_COLUMN_NAME_SIZE = 32;       // 列名最大长度（含结尾0）
+    constexpr size_t TABLE_COLUMN_ALIGNMENT = 64;       // 每列起始地址按缓存行对齐
+
+    // 列的元素类型，与JS的TypedArray一一对应
+    enum class ColumnType : uint32_t {
+        Int8 = 0,
+        Uint8,
+        Int16,
+        Uint16,
+        Int32,
+        Uint32,
+        Float32,
+        Float64,
+    };
+
+    // 列描述
+    struct TableColumn {
+        char name[TABLE_COLUMN_NAME_SIZE];  // 列名
+        uint32_t type;                      // ColumnType
+        uint32_t element_size;              // 元素字节数
+        uint64_t offset;                    // 列数据相对数据区起始位置的偏移
+    };
+
+    // 表格头部，位于数据区起始位置，其后是按列存放（struct-of-arrays）的数据
+    struct TableHeader {
+        uint32_t magic;                     // TABLE_MAGIC
+        uint32_t version;                   // 布局版本
+        uint32_t column_count;              // 列数
+        uint32_t reserved;
+        uint64_t row_capacity;              // 每列可容纳的行数
+        std::atomic<uint64_t> row_count;    // 当前有效行数，多进程共享
+        TableColumn columns[TABLE_MAX_COLUMNS];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "跨进程共享的行数必须是无锁原子变量");
+}
+#endif
@@ -0,0 +1,111 @@
+const sharedMemory = require('../build/sharedMemory.node');
+const keyA = "2150";
+const keyB = "2151";
+
+try {
+    const length = 96 * 1024 * 1024;
+    console.info('-------set--------')
+    const viewA = new Uint8Array(sharedMemory.setMemory(keyA, length));
+    const viewB = new Uint8Array(sharedMemory.setMemory(keyB, length));
+
+    console.info('-------copyIntoMemory--------')
+    const frame = new Uint8Array(length - 1);
+    for (let i = 0; i < frame.length; i++) {
+        frame[i] = i % 251;
+    }
+    let start = Date.now();
+    const copied = sharedMemory.copyIntoMemory(keyA, 1, frame);
+    console.log('拷贝字节数:', copied, '耗时(ms):', Date.now() - start);
+    for (let i = 0; i < frame.length; i += 4093) {
+        if (viewA[i + 1] !== frame[i]) {
+            throw new Error(`copyIntoMemory数据错误: 位置 ${i + 1}`);
+        }
+    }
+
+    // worker之间共享的帧通常放在SharedArrayBuffer中
+    const shared = new SharedArrayBuffer(4096);
+    const sharedFrame = new Uint8Array(shared);
+    for (let i = 0; i < sharedFrame.length; i++) {
+        sharedFrame[i] = (i * 7) % 256;
+    }
+    sharedMemory.copyIntoMemory(keyB, 10, sharedFrame, 16, 1024);
+    sharedMemory.copyIntoMemory(keyB, 2000, new DataView(shared, 8), 0, 64);
+    sharedMemory.copyIntoMemory(keyB, 3000, shared);
+    for (let i = 0; i < 1024; i++) {
+        if (viewB[10 + i] !== sharedFrame[16 + i]) {
+            throw new Error(`copyIntoMemory(SharedArrayBuffer视图)数据错误: 位置 ${i}`);
+        }
+    }
+    for (let i = 0; i < 64; i++) {
+        if (viewB[2000 + i] !== sharedFrame[8 + i]) {
+            throw new Error(`copyIntoMemory(DataView)数据错误: 位置 ${i}`);
+        }
+    }
+    for (let i = 0; i < sharedFrame.length; i++) {
+        if (viewB[3000 + i] !== sharedFrame[i]) {
+            throw new Error(`copyIntoMemory(SharedArrayBuffer)数据错误: 位置 ${i}`);
+        }
+    }
+
+    console.info('-------copyBetween--------')
+    start = Date.now();
+    sharedMemory.copyBetween(keyB, 0, keyA, 0, length);
+    console.log('耗时(ms):', Date.now() - start);
+    if (sharedMemory.compareMemory(keyA, keyB) !== -1) {
+        throw new Error('copyBetween数据错误');
+    }
+
+    console.info('-------fillMemory--------')
+    sharedMemory.fillMemory(keyA, 3, 1000, 0x5A);
+    for (let i = 3; i < 1003; i++) {
+        if (viewA[i] !== 0x5A) {
+            throw new Error(`fillMemory数据错误: 位置 ${i}`);
+        }
+    }
+    const pattern = new Uint8Array([1, 2, 3]);
+    start = Date.now();
+    sharedMemory.fillMemory(keyB, 5, length - 5, pattern);
+    console.log('耗时(ms):', Date.now() - start);
+    for (let i = 5; i < length; i += 4099) {
+        if (viewB[i] !== pattern[(i - 5) % 3]) {
+            throw new Error(`fillMemory模式数据错误: 位置 ${i}`);
+        }
+    }
+    // 模式长度整除64时走向量化填充：4MiB以上使用非临时存储，64MiB以上拆分到多个线程
+    const checkFill = (view, offset, len, pattern) => {
+        const positions = [0, 1, 63, 64, 65, len >> 1, (len >> 1) + 1, len - 65, len - 64, len - 2, len - 1];
+        for (let j = 0; j < len; j += 65521) {
+            positions.push(j);
+        }
+        for (const j of positions) {
+            if (view[offset + j] !== pattern[j % pattern.length]) {
+                throw new Error(`fillMemory向量化填充数据错误: 位置 ${offset + j}`);
+            }
+        }
+        if (view[offset + len] === pattern[len % pattern.length]) {
+            throw new Error('fillMemory写出范围');
+        }
+    };
+    viewB[9 + 8 * 1024 * 1024 + 13] = 0xFF;
+    const pattern4 = new Uint8Array([0x11, 0x22, 0x33, 0x44]);
+    sharedMemory.fillMemory(keyB, 9, 8 * 1024 * 1024 + 13, pattern4);
+    checkFill(viewB, 9, 8 * 1024 * 1024 + 13, pattern4);
+    const pattern16 = new Uint8Array(16).map((_, i) => 0x80 + i);
+    viewA[length - 7] = 0xFF;
+    start = Date.now();
+    sharedMemory.fillMemory(keyA, 5, length - 12, pattern16);
+    console.log('向量化填充耗时(ms):', Date.now() - start);
+    checkFill(viewA, 5, length - 12, pattern16);
+    const sharedPattern = new Uint8Array(new SharedArrayBuffer(2));
+    sharedPattern.set([0xAB, 0xCD]);
+    sharedMemory.fillMemory(keyA, 7, 100, sharedPattern);
+    for (let i = 7; i < 107; i++) {
+        if (viewA[i] !== sharedPattern[(i - 7) % 2]) {
+            throw new Error(`fillMemory(SharedArrayBuffer)数据错误: 位置 ${i}`);
+        }
+    }
+    console.log('校验成功');
+} catch (error) {
+    console.error('操作失败:', error.message);
+    process.exit(1);
+}
@@ -0,0 +1,99 @@
+const sharedMemory = require('../build/sharedMemory.node');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const key = "2140";
+
+(async () => {
+    const input = path.join(os.tmpdir(), 'skyline_file_in.dat');
+    const output = path.join(os.tmpdir(), 'skyline_file_out.dat');
+    try {
+        const length = 32 * 1024 * 1024;
+        const data = Buffer.alloc(length - 100);
+        for (let i = 0; i < data.length; i++) {
+            data[i] = (i * 7) % 256;
+        }
+        fs.writeFileSync(input, data);
+
+        console.info('-------set--------')
+        const view = new Uint8Array(sharedMemory.setMemory(key, length));
+
+        console.info('-------readFileInto--------')
+        let progressCount = 0;
+        let lastProgress = null;
+        const read = await sharedMemory.readFileInto(key, input, 100, {
+            chunkSize: 1024 * 1024,
+            onProgress: (done, total) => {
+                progressCount++;
+                lastProgress = { done, total };
+            },
+        });
+        console.log('读取字节数:', read, '进度回调次数:', progressCount);
+        if (read !== data.length || Buffer.compare(Buffer.from(view.buffer, 100), data) !== 0) {
+            throw new Error('读取文件内容不一致');
+        }
+        if (progressCount === 0 || lastProgress.done !== lastProgress.total || lastProgress.total !== data.length) {
+            throw new Error('进度回调错误');
+        }
+
+        console.info('-------writeFileFrom--------')
+        const written = await sharedMemory.writeFileFrom(key, output, 100, data.length);
+        console.log('写入字节数:', written);
+        if (written !== data.length || Buffer.compare(fs.readFileSync(output), data) !== 0) {
+            throw new Error('写出文件内容不一致');
+        }
+
+        console.info('-------cancel--------')
+        const controller = new AbortController();
+        controller.abort();
+        try {
+            await sharedMemory.readFileInto(key, input, 0, { signal: controller.signal });
+            throw new Error('取消未生效');
+        } catch (e) {
+            console.log('已取消:', e.name, e.message);
+            if (e !== controller.signal.reason) {
+                throw new Error('取消时应以signal.reason拒绝');
+            }
+        }
+        // 传输过程中取消，块设得很小保证收到第一次进度时传输尚未结束
+        const running = new AbortController();
+        try {
+            await sharedMemory.readFileInto(key, input, 0, {
+                chunkSize: 4096,
+                signal: running.signal,
+                onProgress: () => running.abort(),
+            });
+            throw new Error('传输中取消未生效');
+        } catch (e) {
+            console.log('传输中取消:', e.name, e.message);
+            if (e !== running.signal.reason) {
+                throw new Error('传输中取消时应以signal.reason拒绝');
+            }
+        }
+        // 空传输同样要以signal.reason拒绝
+        try {
+            await sharedMemory.writeFileFrom(key, output, 0, 0, { signal: controller.signal });
+            throw new Error('空传输取消未生效');
+        } catch (e) {
+            if (e !== controller.signal.reason) {
+                throw new Error('空传输取消时应以signal.reason拒绝');
+            }
+        }
+        try {
+            await sharedMemory.readFileInto(key, input, 0, { signal: { aborted: false } });
+            throw new Error('非法signal未被拒绝');
+        } catch (e) {
+            console.log('非法signal:', e.message);
+            if (e.message !== 'signal必须是AbortSignal') {
+                throw e;
+            }
+        }
+        console.log('校验成功');
+    } catch (error) {
+        console.error('操作失败:', error.message);
+        process.exit(1);
+    } finally {
+        fs.rmSync(input, { force: true });
+        fs.rmSync(output, { force: true });
+    }
+})();
@@ -0,0 +1,78 @@
+const sharedMemory = require('../build/sharedMemory.node');
+const keyA = "2130";
+const keyB = "2131";
+
+// 逐字节查表计算CRC32C，用于校验原生实现（包括多线程分段后的合并）
+function crc32c(bytes) {
+    const table = new Uint32Array(256);
+    for (let i = 0; i < 256; i++) {
+        let crc = i;
+        for (let k = 0; k < 8; k++) {
+            crc = crc & 1 ? (crc >>> 1) ^ 0x82F63B78 : crc >>> 1;
+        }
+        table[i] = crc;
+    }
+    let crc = 0xFFFFFFFF;
+    for (let i = 0; i < bytes.length; i++) {
+        crc = (crc >>> 8) ^ table[(crc ^ bytes[i]) & 0xFF];
+    }
+    return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+try {
+    const length = 16 * 1024 * 1024;
+    console.info('-------set--------')
+    const viewA = new Uint8Array(sharedMemory.setMemory(keyA, length));
+    const viewB = new Uint8Array(sharedMemory.setMemory(keyB, length));
+    for (let i = 0; i < length; i++) {
+        viewA[i] = i % 256;
+        viewB[i] = i % 256;
+    }
+
+    console.info('-------hash--------')
+    // "123456789"的CRC32C标准值为0xE3069283
+    viewA.set(Buffer.from('123456789'), 0);
+    const small = sharedMemory.hashMemory(keyA, 0, 9);
+    console.log('CRC32C("123456789"):', small.toString(16));
+    if (small !== 0xE3069283) {
+        throw new Error('CRC32C校验值错误');
+    }
+    viewA.set(viewB.subarray(0, 9), 0);
+
+    const hashA = sharedMemory.hashMemory(keyA);
+    const hashB = sharedMemory.hashMemory(keyB);
+    console.log('hashA:', hashA.toString(16), 'hashB:', hashB.toString(16));
+    if (hashA !== hashB) {
+        throw new Error('相同内容的校验值不一致');
+    }
+    // 超过8MiB会拆分到多个线程再合并，与逐字节计算的结果比较
+    const expected = crc32c(viewA);
+    if (hashA !== expected) {
+        throw new Error(`多线程CRC32C错误: ${hashA.toString(16)}，期望值为 ${expected.toString(16)}`);
+    }
+    const unaligned = sharedMemory.hashMemory(keyA, 3, length - 10);
+    if (unaligned !== crc32c(viewA.subarray(3, length - 7))) {
+        throw new Error('非对齐区间的CRC32C错误');
+    }
+
+    console.info('-------compare--------')
+    let diff = sharedMemory.compareMemory(keyA, keyB);
+    console.log('相同内容的比较结果:', diff);
+    if (diff !== -1) {
+        throw new Error('相同内容比较结果错误');
+    }
+    const position = 12345678;
+    viewB[position] ^= 0xFF;
+    diff = sharedMemory.compareMemory(keyA, keyB);
+    console.log('修改后的比较结果:', diff);
+    if (diff !== position) {
+        throw new Error(`比较结果错误: ${diff}，期望值为 ${position}`);
+    }
+    if (sharedMemory.hashMemory(keyB) === hashA) {
+        throw new Error('修改后校验值未变化');
+    }
+    console.log('校验成功');
+} catch (error) {
+    console.error('操作失败:', error.message);
+    process.exit(1);
+}
@@ -0,0 +1,62 @@
+const sharedMemory = require('../build/sharedMemory.node');
+const key = "2160";
+
+try {
+    const capacity = 100000;
+    console.info('-------createTable--------')
+    const table = sharedMemory.createTable(key, [
+        { name: 'x', type: 'float32' },
+        { name: 'y', type: 'float32' },
+        { name: 'depth', type: 'int32' },
+        { name: 'flags', type: 'uint8' },
+    ], capacity);
+    console.log('capacity:', table.capacity, 'columns:', Object.keys(table.columns));
+
+    const { x, depth } = table.columns;
+    const rows = 5000;
+    for (let i = 0; i < rows; i++) {
+        x[i] = i * 0.5;
+        depth[i] = i % 100 - 50;
+    }
+    sharedMemory.setTableRowCount(key, rows);
+
+    console.info('-------openTable--------')
+    const opened = sharedMemory.openTable(key);
+    if (opened.columns.x[10] !== 5 || sharedMemory.getTableRowCount(key) !== rows) {
+        throw new Error('openTable数据不一致');
+    }
+
+    console.info('-------tableFilterRange--------')
+    const hits = sharedMemory.tableFilterRange(key, 'x', 100, 200);
+    console.log('命中行数:', hits.length, '首行:', hits[0]);
+    if (hits.length !== 201 || hits[0] !== 200 || hits[200] !== 400) {
+        throw new Error('tableFilterRange结果错误');
+    }
+    // 界限不能被舍入到float后把区间外的行包含进来
+    const narrow = sharedMemory.tableFilterRange(key, 'x', 100.00000001, 199.99999999);
+    if (narrow.length !== 199 || narrow[0] !== 201 || narrow[198] !== 399) {
+        throw new Error('tableFilterRange界限舍入错误');
+    }
+    // 结果数组只占用命中行数大小的内存
+    if (hits.buffer.byteLength !== hits.length * 4) {
+        throw new Error('tableFilterRange结果缓冲区大小错误');
+    }
+
+    console.info('-------tableGather--------')
+    const values = sharedMemory.tableGather(key, 'depth', new Uint32Array([0, 1, 149]));
+    console.log('收集结果:', values);
+    if (!(values instanceof Int32Array) || values[0] !== -50 || values[1] !== -49 || values[2] !== -1) {
+        throw new Error('tableGather结果错误');
+    }
+
+    console.info('-------tableAggregate--------')
+    const stats = sharedMemory.tableAggregate(key, 'depth');
+    console.log('统计结果:', stats);
+    if (stats.count !== rows || stats.min !== -50 || stats.max !== 49 || stats.sum !== -2500) {
+        throw new Error('tableAggregate结果错误');
+    }
+    console.log('校验成功');
+} catch (error) {
+    console.error('操作失败:', error.message);
+    process.exit(1);
+}